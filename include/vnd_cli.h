@@ -10,6 +10,7 @@
 #include <zephyr/bluetooth/mesh.h>
 #include <zephyr/kernel.h>
 #include "vnd_common.h"
+#include "vnd_stats.h"
 
 /**
  * @brief Vendor Client Model
@@ -21,6 +22,228 @@
 extern "C" {
 #endif
 
+struct bt_mesh_vendor_cli;
+
+/** @brief Completion callback for asynchronous requests
+ *
+ * Called from the Bluetooth receive thread when the response arrives, or from
+ * the system workqueue when the request times out.
+ *
+ * @param[in] cli       Vendor Client model
+ * @param[in] ctx       Message context of the response, or NULL if no response
+ *                      arrived
+ * @param[in] status    Response, or NULL if @p err is set. The data is only
+ *                      valid for the duration of the callback.
+ * @param[in] err       0 on success, -ETIMEDOUT if no response arrived in time,
+ *                      -ECANCELED if the request was cancelled, -EALREADY if
+ *                      the server's data is unchanged since the version passed to
+ *                      @ref bt_mesh_vendor_cli_get_cond_async, or the error
+ *                      listed in @ref bt_mesh_vendor_cli_cmd_async if the
+ *                      server didn't complete a command
+ * @param[in] user_data User data passed with the request
+ */
+typedef void (*bt_mesh_vendor_cli_cb_t)(struct bt_mesh_vendor_cli *cli,
+					struct bt_mesh_msg_ctx *ctx,
+					const struct bt_mesh_vendor_status *status,
+					int err, void *user_data);
+
+/** Vendor Client transaction, tracking one acknowledged request */
+struct bt_mesh_vendor_cli_txn {
+	/** Completion callback */
+	bt_mesh_vendor_cli_cb_t cb;
+	/** User data for the completion callback */
+	void *user_data;
+	/** Uptime at which the request times out, in milliseconds */
+	int64_t deadline;
+	/** Destination address of the request */
+	uint16_t addr;
+	/** Timeout of the first attempt, in milliseconds */
+	uint32_t rto;
+	/** Transaction ID of the request */
+	uint8_t tid;
+	/** Whether the request was sent without the transaction ID */
+	bool compact;
+	/** Whether the entry is in use */
+	bool busy;
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	/** Opcode of the request */
+	uint32_t op;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STATS) || defined(CONFIG_BT_MESH_VENDOR_PACE) || \
+	defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	/** Uptime at which the request was sent, in milliseconds */
+	int64_t start;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	/** Whether the request waits in the send pacer queue. Its timeouts start once it's
+	 *  sent.
+	 */
+	bool queued;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	/** Uptime at which the last attempt times out, in milliseconds */
+	int64_t end;
+	/** Destination, unused if @c pub is set */
+	struct bt_mesh_msg_ctx ctx;
+	/** Length of the request in @c msg, zero if it's too long to send again */
+	uint16_t len;
+	/** Number of times the request has been sent again */
+	uint8_t retries;
+	/** Priority class of the request */
+	uint8_t prio;
+	/** Whether the request was sent with the publish parameters */
+	bool pub;
+	/** Copy of the request, to send again */
+	uint8_t msg[CONFIG_BT_MESH_VENDOR_CLI_RETRY_MSG_LEN];
+#endif
+};
+
+/** Round trip time estimate of one server, see @ref bt_mesh_vendor_cli_rtt_get */
+struct bt_mesh_vendor_cli_rtt {
+	/** Unicast address of the server, or BT_MESH_ADDR_UNASSIGNED if the entry is free */
+	uint16_t addr;
+	/** Smoothed round trip time, in milliseconds */
+	uint32_t srtt;
+	/** Round trip time variation, in milliseconds */
+	uint32_t rttvar;
+	/** Timeout of the next request's first attempt, in milliseconds */
+	uint32_t rto;
+	/** Number of round trip times measured */
+	uint32_t samples;
+	/** Number of requests sent again */
+	uint32_t retries;
+	/** Number of requests that got no response */
+	uint32_t timeouts;
+};
+
+/** STATUS reply collected from one server by @ref bt_mesh_vendor_cli_get_collect */
+struct bt_mesh_vendor_cli_reply {
+	/** Source address of the reply */
+	uint16_t addr;
+	/** Buffer the reply data is copied into, or NULL to only record the
+	 *  address. Data that doesn't fit is truncated.
+	 */
+	struct net_buf_simple *buf;
+};
+
+/** Key-value record, see @ref bt_mesh_vendor_cli_kv_get and @ref bt_mesh_vendor_cli_kv_set */
+struct bt_mesh_vendor_kv_rec {
+	/** Key */
+	uint8_t key;
+	/** Length of the value. For a get, the size of @c value before the call,
+	 *  and the length of the value received after it, or 0 if the server
+	 *  doesn't have the key.
+	 */
+	uint8_t len;
+	/** Value */
+	void *value;
+};
+
+/** @brief Key-value notification handler
+ *
+ * @param[in] cli   Vendor Client model
+ * @param[in] ctx   Message context
+ * @param[in] key   Key that changed
+ * @param[in] value New value of the key
+ * @param[in] len   Length of the value
+ */
+typedef void (*bt_mesh_vendor_cli_kv_handler_t)(struct bt_mesh_vendor_cli *cli,
+						struct bt_mesh_msg_ctx *ctx, uint8_t key,
+						const void *value, size_t len);
+
+/** Last acknowledged SET payload sent to a server, the base of delta SETs */
+struct bt_mesh_vendor_cli_image {
+	/** Address of the server, or BT_MESH_ADDR_UNASSIGNED if the entry is free */
+	uint16_t addr;
+	/** Length of the payload */
+	uint16_t len;
+	/** Version of the payload, see @ref bt_mesh_vendor_version */
+	uint32_t version;
+	/** Value of @c delta.seq when the entry was last used */
+	uint32_t seq;
+	/** Payload */
+	uint8_t data[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+};
+
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+/** SET_UNACK records waiting to be sent to one destination */
+struct bt_mesh_vendor_cli_batch {
+	/** Destination, unused if @c pub is set */
+	struct bt_mesh_msg_ctx ctx;
+	/** Uptime at which the batch is sent, in milliseconds */
+	int64_t deadline;
+	/** Length of the records in @c data */
+	uint16_t len;
+	/** Number of records, zero if the entry is free */
+	uint8_t count;
+	/** Whether the batch is sent with the publish parameters */
+	bool pub;
+	/** Records, each a length byte followed by the data */
+	uint8_t data[CONFIG_BT_MESH_VENDOR_BATCH_SIZE];
+};
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+/** Message waiting for the pacer to send it */
+struct bt_mesh_vendor_cli_pace_msg {
+	/** Destination, unused if @c pub is set */
+	struct bt_mesh_msg_ctx ctx;
+	/** Length of the message in @c data */
+	uint16_t len;
+	/** Uptime at which the message was queued, in milliseconds */
+	int64_t queued;
+	/** Queue order, to send messages of the same class oldest first */
+	uint32_t seq;
+	/** Priority class, see @ref bt_mesh_vendor_prio */
+	uint8_t prio;
+	/** Transaction ID of the request, or @ref BT_MESH_VENDOR_TID_NONE */
+	uint8_t tid;
+	/** Whether the message is sent with the publish parameters */
+	bool pub;
+	/** Whether the entry is in use */
+	bool busy;
+	/** Message, including the opcode */
+	uint8_t data[BT_MESH_MODEL_BUF_LEN(BT_MESH_VENDOR_OP_SET,
+					   BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET)];
+};
+#endif
+
+/** Send pacer counters of one priority class */
+struct bt_mesh_vendor_cli_pace_class {
+	/** Messages sent */
+	uint32_t sent;
+	/** Total time the sent messages waited in the queue, in milliseconds */
+	uint32_t wait_total;
+	/** Longest time a sent message waited in the queue, in milliseconds */
+	uint32_t wait_max;
+	/** Messages waiting in the queue */
+	uint8_t queued;
+};
+
+/** Send pacer state, see @ref bt_mesh_vendor_cli_pace_get */
+struct bt_mesh_vendor_cli_pace_status {
+	/** Current send rate, in transport segments per second */
+	uint16_t rate;
+	/** Smoothed round trip time of acknowledged requests, in milliseconds */
+	uint32_t srtt;
+	/** Number of messages waiting to be sent */
+	uint8_t queued;
+	/** Counters of each priority class, indexed by @ref bt_mesh_vendor_prio */
+	struct bt_mesh_vendor_cli_pace_class classes[BT_MESH_VENDOR_PRIO_COUNT];
+};
+
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+/** Record kept in the stream retransmit ring */
+struct bt_mesh_vendor_cli_stream_rec {
+	/** Offset of the data in the ring */
+	uint16_t off;
+	/** Length of the data */
+	uint16_t len;
+	/** Priority class the record is sent at */
+	uint8_t prio;
+};
+#endif
+
 /** Vendor Client Model Context */
 struct bt_mesh_vendor_cli {
 	/** Vendor model entry */
@@ -30,9 +253,149 @@ struct bt_mesh_vendor_cli {
 	/** Publication message */
 	struct net_buf_simple pub_msg;
 	/** Publication message buffer */
-	uint8_t buf[BT_MESH_VENDOR_MSG_MAXLEN_SET + 3 + 4];
-	/** Acknowledged message tracking */
-	struct bt_mesh_msg_ack_ctx ack_ctx;
+	uint8_t buf[BT_MESH_MODEL_BUF_LEN(BT_MESH_VENDOR_OP_SET,
+					  BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET)];
+	/** Outstanding acknowledged requests */
+	struct bt_mesh_vendor_cli_txn txn[CONFIG_BT_MESH_VENDOR_CLI_TXN_COUNT];
+	/** Protects the transaction table */
+	struct k_spinlock lock;
+	/** Times out pending transactions */
+	struct k_work_delayable timeout_work;
+	/** Last transaction ID used */
+	uint8_t tid;
+	/** Servers whose compact request timed out, sent regular requests until a late
+	 *  Vendor_Status_C can no longer arrive, protected by @c lock
+	 */
+	struct {
+		/** Unicast address of the server, or BT_MESH_ADDR_UNASSIGNED if the entry is free */
+		uint16_t addr;
+		/** Uptime at which compact requests may be sent again, in milliseconds */
+		int64_t until;
+	} compact_hold[CONFIG_BT_MESH_VENDOR_CLI_TXN_COUNT];
+	/** Capabilities of recently addressed servers, protected by @c lock */
+	struct bt_mesh_vendor_peer peers[CONFIG_BT_MESH_VENDOR_PEER_COUNT];
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	/** Round trip times of recently addressed servers, most recently used first,
+	 *  protected by @c lock
+	 */
+	struct bt_mesh_vendor_cli_rtt rtt[CONFIG_BT_MESH_VENDOR_CLI_RTT_COUNT];
+#endif
+	/** Group GET collection state, protected by @c lock */
+	struct {
+		/** Caller's reply array */
+		struct bt_mesh_vendor_cli_reply *replies;
+		/** Number of replies to wait for */
+		size_t max;
+		/** Number of replies received */
+		size_t count;
+		/** Given when @c max replies have been received */
+		struct k_sem done;
+		/** Transaction ID of the GET */
+		uint8_t tid;
+		/** Whether a collection is ongoing */
+		bool active;
+	} collect;
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	/** Delta SET state, protected by @c lock */
+	struct {
+		/** Base payload of each server */
+		struct bt_mesh_vendor_cli_image images[CONFIG_BT_MESH_VENDOR_DELTA_PEER_COUNT];
+		/** Use counter, to find the least recently used image */
+		uint32_t seq;
+	} delta;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+	/** SET_UNACK batching state, protected by @c lock */
+	struct {
+		/** Pending batches */
+		struct bt_mesh_vendor_cli_batch slots[CONFIG_BT_MESH_VENDOR_BATCH_DEST_COUNT];
+		/** Sends batches when they time out */
+		struct k_work_delayable work;
+		/** Whether SET_UNACK payloads are batched */
+		bool enabled;
+	} batch;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	/** Stream state, protected by @c lock */
+	struct {
+		/** Destination, unused if @c pub is set */
+		struct bt_mesh_msg_ctx ctx;
+		/** Sends the records the server asked for again */
+		struct k_work repair_work;
+		/** Records in the ring, indexed by sequence number modulo
+		 *  @ref BT_MESH_VENDOR_STREAM_WINDOW
+		 */
+		struct bt_mesh_vendor_cli_stream_rec recs[BT_MESH_VENDOR_STREAM_WINDOW];
+		/** Records to send again, bit n refers to @c recs[n] */
+		uint32_t repair;
+		/** Offset of the next record in @c ring */
+		uint16_t head;
+		/** Number of bytes in @c ring in use */
+		uint16_t used;
+		/** Sequence number of the next record */
+		uint16_t seq;
+		/** Number of records in the ring, the last ones sent */
+		uint8_t count;
+		/** Stream ID */
+		uint8_t id;
+		/** Whether the stream is sent with the publish parameters */
+		bool pub;
+		/** Whether a stream is started */
+		bool active;
+		/** Data of the last records sent */
+		uint8_t ring[CONFIG_BT_MESH_VENDOR_STREAM_RING_SIZE];
+	} stream;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	/** Send pacer state, protected by @c lock */
+	struct {
+		/** Messages waiting for tokens */
+		struct bt_mesh_vendor_cli_pace_msg queue[CONFIG_BT_MESH_VENDOR_PACE_QUEUE_LEN];
+		/** Counters of each priority class */
+		struct bt_mesh_vendor_cli_pace_class classes[BT_MESH_VENDOR_PRIO_COUNT];
+		/** Sends queued messages as tokens become available */
+		struct k_work_delayable work;
+		/** Called when the queue has drained after refusing a message */
+		void (*ready)(struct bt_mesh_vendor_cli *cli);
+		/** Uptime of the last token refill, in milliseconds */
+		int64_t refill;
+		/** Uptime of the last rate decrease, in milliseconds */
+		int64_t decreased;
+		/** Tokens in the bucket, in thousandths of a segment */
+		uint32_t tokens;
+		/** Segments sent since the last rate increase */
+		uint32_t credit;
+		/** Smoothed round trip time, in milliseconds */
+		uint32_t srtt;
+		/** Send rate, in segments per second */
+		uint16_t rate;
+		/** Queue order of the next message */
+		uint32_t seq;
+		/** Number of messages in @c queue */
+		uint8_t count;
+		/** Whether the last round trip time was well above the average */
+		bool rtt_rising;
+		/** Whether a message was refused since the queue last drained */
+		bool refused;
+	} pace;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	/** Called for every key a server publishes, protected by @c lock */
+	bt_mesh_vendor_cli_kv_handler_t kv_handler;
+#endif
+	/** Bulk transfer state */
+	struct {
+		/** Vendor_Bulk_Ack tracking */
+		struct bt_mesh_msg_ack_ctx ack_ctx;
+		/** Given when the previous chunk has left the transport layer */
+		struct k_sem tx_sem;
+		/** Current transfer ID */
+		uint8_t id;
+	} bulk;
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	/** Vendor_Stats_Status tracking */
+	struct bt_mesh_msg_ack_ctx stats_ack;
+#endif
 	/** @brief Status message handler
 	 *
 	 * Called when a Vendor_Status message is received
@@ -75,42 +438,583 @@ extern const struct bt_mesh_model_cb _bt_mesh_vendor_cli_cb;
 /**
  * @brief Send a vendor set message
  *
+ * Several requests may be outstanding at once, to the same or to different
+ * servers, up to @kconfig{CONFIG_BT_MESH_VENDOR_CLI_TXN_COUNT}. Each request
+ * carries its own transaction ID, which the server echoes in the response.
+ *
  * @param cli      Vendor Client model
  * @param ctx      Message context, or NULL to use the configured publish parameters
  * @param set      Vendor set message to send
- * @return 0 on success, or negative error code otherwise
+ * @param rsp      Status response, or NULL to not wait for a response. If
+ *                 @c rsp->buf is set, the response data is copied into it.
+ * @return 0 on success, -EBUSY if all transactions are in use, -ENOBUFS if
+ *         the response didn't fit in @c rsp->buf, or negative error code otherwise
  */
 int bt_mesh_vendor_cli_set(struct bt_mesh_vendor_cli *cli,
 			   struct bt_mesh_msg_ctx *ctx,
 			   const struct bt_mesh_vendor_set *set,
 			   struct bt_mesh_vendor_status *rsp);
 
+/**
+ * @brief Send a vendor set message as a delta to the previous one
+ *
+ * If the client has the last payload acknowledged by the server, only the
+ * byte ranges that differ from it are sent, along with the version of the
+ * payload they apply to. If the server has a different base, or the delta
+ * isn't shorter than the payload, the full payload is sent instead. Always
+ * waits for the response, as the payload becomes the new base when it's
+ * acknowledged.
+ *
+ * Requires @kconfig{CONFIG_BT_MESH_VENDOR_DELTA}. Group destinations always
+ * get the full payload.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param data     Payload
+ * @param len      Length of the payload
+ * @param rsp      Status response, or NULL. If @c rsp->buf is set, the
+ *                 response data is copied into it.
+ * @return 0 on success, -EBUSY if all transactions are in use, or negative
+ *         error code otherwise
+ */
+int bt_mesh_vendor_cli_set_delta(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const uint8_t *data, size_t len,
+				 struct bt_mesh_vendor_status *rsp);
+
 /**
  * @brief Send a vendor get message and wait for status response
  *
  * @param cli      Vendor Client model
  * @param ctx      Message context, or NULL to use the configured publish parameters
  * @param get      Vendor get message parameter (see @ref bt_mesh_vendor_get), can be NULL
- * @param rsp      Status response buffer, filled with the response data on success
- * @return 0 on success, or negative error code otherwise
+ * @param rsp      Status response, or NULL to not wait for a response. If
+ *                 @c rsp->buf is set, the response data is copied into it.
+ * @return 0 on success, -EBUSY if all transactions are in use, -ENOBUFS if
+ *         the response didn't fit in @c rsp->buf, or negative error code otherwise
  */
 int bt_mesh_vendor_cli_get(struct bt_mesh_vendor_cli *cli,
 			   struct bt_mesh_msg_ctx *ctx,
 			   const struct bt_mesh_vendor_get *get,
 			   struct bt_mesh_vendor_status *rsp);
 
+/**
+ * @brief Send a conditional vendor get message and wait for status response
+ *
+ * The server only sends its data if it differs from the data the client
+ * already has, identified by its version (see @ref bt_mesh_vendor_version).
+ * Otherwise, it answers with a short Vendor_Not_Modified message.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param get      Vendor get message parameter (see @ref bt_mesh_vendor_get), can be NULL
+ * @param version  Version of the data in @c rsp->buf. Updated when new data
+ *                 arrives. Start with 0 and an empty @c rsp->buf.
+ * @param rsp      Status response. The new data is copied into @c rsp->buf,
+ *                 which must be set.
+ * @return 0 if new data was received, -EALREADY if the data is unchanged,
+ *         or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_get_cond(struct bt_mesh_vendor_cli *cli,
+				struct bt_mesh_msg_ctx *ctx,
+				const struct bt_mesh_vendor_get *get,
+				uint32_t *version,
+				struct bt_mesh_vendor_status *rsp);
+
+/**
+ * @brief Send a vendor get message and collect the status of every server
+ *
+ * Intended for group and virtual addresses, where many servers answer the
+ * same request. Every STATUS that answers the GET is stored in @p replies,
+ * one entry per source address, in the order they arrive. Replies are also
+ * passed to the status handler, as usual.
+ *
+ * Only one collection can be ongoing per client.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param get      Vendor get message parameter (see @ref bt_mesh_vendor_get), can be NULL
+ * @param replies  Array to store the replies in. The @c buf of each entry
+ *                 must be set, or NULL, before calling.
+ * @param max      Number of entries in @p replies. Returns as soon as this
+ *                 many servers have answered.
+ * @param timeout  Time to wait for replies
+ * @return Number of replies received, -EBUSY if a collection is already
+ *         ongoing, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_get_collect(struct bt_mesh_vendor_cli *cli,
+				   struct bt_mesh_msg_ctx *ctx,
+				   const struct bt_mesh_vendor_get *get,
+				   struct bt_mesh_vendor_cli_reply *replies,
+				   size_t max, k_timeout_t timeout);
+
+/**
+ * @brief Read a dataset larger than one status, page by page
+ *
+ * Sends a Vendor_Get_Page for the first
+ * @kconfig{CONFIG_BT_MESH_VENDOR_PAGE_SIZE} bytes, which also tells the
+ * length of the dataset. The remaining pages are then asked for with up to
+ * @kconfig{CONFIG_BT_MESH_VENDOR_PAGE_WINDOW} requests in flight, and each
+ * page is written to @p buf at its offset as it arrives. Pages are sent at
+ * bulk priority, and requests that time out are sent again like any other.
+ *
+ * This call blocks until every page has arrived, or the read fails.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, must have a unicast destination
+ * @param buf      Buffer to read the dataset into
+ * @param size     Size of @p buf. Only the start of a longer dataset is read.
+ * @param total    Length of the dataset, which may be larger than @p size,
+ *                 or NULL
+ * @return 0 on success, -ENOTSUP if the server has no page read handler or
+ *         @kconfig{CONFIG_BT_MESH_VENDOR_PAGE} is disabled, -EIO if the
+ *         server failed to read a page, -ESTALE if the length of the dataset
+ *         changed during the read, -ETIMEDOUT if the server stopped
+ *         responding, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_get_object(struct bt_mesh_vendor_cli *cli,
+				  struct bt_mesh_msg_ctx *ctx,
+				  void *buf, size_t size, size_t *total);
+
+/**
+ * @brief Read several keys of a server's key-value store
+ *
+ * Sends a Vendor_KV_Get with every key and waits for the Vendor_KV_Status,
+ * which carries the values in the order the keys were asked for.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param recs     Keys to read. The value of each is copied into its
+ *                 @c value, and its @c len is updated.
+ * @param count    Number of entries in @p recs
+ * @return 0 on success, -ENOENT if the server doesn't have one of the keys,
+ *         -ENOBUFS if a value is longer than its buffer, -EMSGSIZE if the
+ *         values don't all fit in one status, -ENOTSUP if
+ *         @kconfig{CONFIG_BT_MESH_VENDOR_KV} is disabled, or negative error
+ *         code otherwise
+ */
+int bt_mesh_vendor_cli_kv_get(struct bt_mesh_vendor_cli *cli,
+			      struct bt_mesh_msg_ctx *ctx,
+			      struct bt_mesh_vendor_kv_rec *recs, size_t count);
+
+/**
+ * @brief Write several keys of a server's key-value store
+ *
+ * Sends a Vendor_KV_Set with every record and waits for the
+ * Vendor_KV_Set_Status. Keys the server doesn't have, can't be written or
+ * have a different length aren't written, the others are.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param recs     Keys and values to write
+ * @param count    Number of entries in @p recs
+ * @return 0 on success, -EPERM if the server didn't write some of the keys,
+ *         -EMSGSIZE if the records don't fit in one message, -ENOTSUP if
+ *         @kconfig{CONFIG_BT_MESH_VENDOR_KV} is disabled, or negative error
+ *         code otherwise
+ */
+int bt_mesh_vendor_cli_kv_set(struct bt_mesh_vendor_cli *cli,
+			      struct bt_mesh_msg_ctx *ctx,
+			      const struct bt_mesh_vendor_kv_rec *recs, size_t count);
+
+/**
+ * @brief Write several keys of a server's key-value store without a response
+ *
+ * A single key with a value of up to six bytes fits in one unsegmented
+ * message.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param recs     Keys and values to write
+ * @param count    Number of entries in @p recs
+ * @return 0 on success, -EMSGSIZE if the records don't fit in one message,
+ *         -ENOTSUP if @kconfig{CONFIG_BT_MESH_VENDOR_KV} is disabled, or
+ *         negative error code otherwise
+ */
+int bt_mesh_vendor_cli_kv_set_unack(struct bt_mesh_vendor_cli *cli,
+				    struct bt_mesh_msg_ctx *ctx,
+				    const struct bt_mesh_vendor_kv_rec *recs, size_t count);
+
+/**
+ * @brief Set the handler for keys published by servers
+ *
+ * Servers publish the keys that change in a Vendor_KV_Status. The handler
+ * is called for every key in it.
+ *
+ * @param cli      Vendor Client model
+ * @param handler  Handler, or NULL to remove it
+ * @return 0 on success, -ENOTSUP if @kconfig{CONFIG_BT_MESH_VENDOR_KV} is
+ *         disabled
+ */
+int bt_mesh_vendor_cli_kv_handler_set(struct bt_mesh_vendor_cli *cli,
+				      bt_mesh_vendor_cli_kv_handler_t handler);
+
+/**
+ * @brief Send a vendor set message without blocking
+ *
+ * Returns as soon as the message is sent. The outcome is reported through
+ * @p cb, which is only called if this function returns 0.
+ *
+ * Payloads of up to @ref BT_MESH_VENDOR_MSG_MAXLEN_SET_C bytes are sent as a
+ * compact Vendor_Set_C without the transaction ID, unless a compact request
+ * to the same destination is already outstanding. This lets them, and their
+ * response, be one byte longer before they need to be segmented.
+ *
+ * @param cli       Vendor Client model
+ * @param ctx       Message context, or NULL to use the configured publish parameters
+ * @param set       Vendor set message to send
+ * @param cb        Completion callback
+ * @param user_data User data passed to @p cb
+ * @param tid       Transaction ID of the request, for @ref bt_mesh_vendor_cli_cancel, can be NULL
+ * @return 0 on success, -EBUSY if all transactions are in use, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_set_async(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const struct bt_mesh_vendor_set *set,
+				 bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				 uint8_t *tid);
+
+/**
+ * @brief Send a vendor get message without blocking
+ *
+ * Returns as soon as the message is sent. The outcome is reported through
+ * @p cb, which is only called if this function returns 0.
+ *
+ * @param cli       Vendor Client model
+ * @param ctx       Message context, or NULL to use the configured publish parameters
+ * @param get       Vendor get message parameter (see @ref bt_mesh_vendor_get), can be NULL
+ * @param cb        Completion callback
+ * @param user_data User data passed to @p cb
+ * @param tid       Transaction ID of the request, for @ref bt_mesh_vendor_cli_cancel, can be NULL
+ * @return 0 on success, -EBUSY if all transactions are in use, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_get_async(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const struct bt_mesh_vendor_get *get,
+				 bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				 uint8_t *tid);
+
+/**
+ * @brief Send a conditional vendor get message without blocking
+ *
+ * Like @ref bt_mesh_vendor_cli_get_async, but the server only sends its
+ * data if its version differs from @p version. Otherwise, @p cb is called
+ * with -EALREADY.
+ *
+ * @param cli       Vendor Client model
+ * @param ctx       Message context, or NULL to use the configured publish parameters
+ * @param get       Vendor get message parameter (see @ref bt_mesh_vendor_get), can be NULL
+ * @param version   Version of the data the client has (see @ref bt_mesh_vendor_version)
+ * @param cb        Completion callback
+ * @param user_data User data passed to @p cb
+ * @param tid       Transaction ID of the request, for @ref bt_mesh_vendor_cli_cancel, can be NULL
+ * @return 0 on success, -EBUSY if all transactions are in use, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_get_cond_async(struct bt_mesh_vendor_cli *cli,
+				      struct bt_mesh_msg_ctx *ctx,
+				      const struct bt_mesh_vendor_get *get,
+				      uint32_t version,
+				      bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				      uint8_t *tid);
+
+/**
+ * @brief Send a vendor command without blocking
+ *
+ * Sends a Vendor_Cmd with the given command ID and parameters. The server
+ * looks the command up in its command table and answers with a
+ * Vendor_Cmd_Status. Requires @kconfig{CONFIG_BT_MESH_VENDOR_CMD}.
+ *
+ * Returns as soon as the message is sent. The outcome is reported through
+ * @p cb, which is only called if this function returns 0. The response
+ * parameters are passed as the status data. If the server doesn't complete
+ * the command, @p cb is called with -ENOENT if the server doesn't know the
+ * command, -EINVAL if the command doesn't accept the parameter length, or
+ * -EIO if the command handler failed.
+ *
+ * @param cli       Vendor Client model
+ * @param ctx       Message context, or NULL to use the configured publish parameters
+ * @param cmd       Command ID
+ * @param params    Command parameters, can be NULL if @p len is 0
+ * @param len       Length of the command parameters, at most
+ *                  @ref BT_MESH_VENDOR_CMD_PARAMS_MAXLEN
+ * @param cb        Completion callback
+ * @param user_data User data passed to @p cb
+ * @param tid       Transaction ID of the request, for @ref bt_mesh_vendor_cli_cancel, can be NULL
+ * @return 0 on success, -EBUSY if all transactions are in use, -EMSGSIZE if
+ *         the parameters are too long, -ENOTSUP if commands are disabled, or
+ *         negative error code otherwise
+ */
+int bt_mesh_vendor_cli_cmd_async(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx, uint8_t cmd,
+				 const void *params, size_t len,
+				 bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				 uint8_t *tid);
+
+/**
+ * @brief Send a vendor command and wait for the response
+ *
+ * Blocking version of @ref bt_mesh_vendor_cli_cmd_async.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param cmd      Command ID
+ * @param params   Command parameters, can be NULL if @p len is 0
+ * @param len      Length of the command parameters
+ * @param rsp      Response, or NULL. If @c rsp->buf is set, the response
+ *                 parameters are copied into it.
+ * @return 0 on success, -ENOENT, -EINVAL or -EIO if the server didn't
+ *         complete the command, -ENOBUFS if the response didn't fit in
+ *         @c rsp->buf, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_cmd(struct bt_mesh_vendor_cli *cli,
+			   struct bt_mesh_msg_ctx *ctx, uint8_t cmd,
+			   const void *params, size_t len,
+			   struct bt_mesh_vendor_status *rsp);
+
+/**
+ * @brief Cancel a pending asynchronous request
+ *
+ * The completion callback is called with -ECANCELED before this function returns.
+ * A response arriving later is only passed to the status handler.
+ *
+ * @param cli      Vendor Client model
+ * @param tid      Transaction ID of the request
+ * @return 0 on success, or -ENOENT if the request is no longer pending
+ */
+int bt_mesh_vendor_cli_cancel(struct bt_mesh_vendor_cli *cli, uint8_t tid);
+
 /**
  * @brief Send a vendor set unacknowledged message
  *
+ * When batching is enabled, the payload is added to the batch for the
+ * destination instead, unless it's longer than
+ * @ref BT_MESH_VENDOR_BATCH_RECORD_MAXLEN or doesn't fit in an empty batch.
+ *
  * @param cli      Vendor Client model
  * @param ctx      Message context, or NULL to use the configured publish parameters
  * @param set      Vendor set message to send
- * @return 0 on success, or negative error code otherwise
+ * @return 0 on success, -EAGAIN if the send pacer's queue is full, or
+ *         negative error code otherwise
  */
 int bt_mesh_vendor_cli_set_unack(struct bt_mesh_vendor_cli *cli,
 			         struct bt_mesh_msg_ctx *ctx,
 			         const struct bt_mesh_vendor_set *set);
 
+/**
+ * @brief Check whether a set message is sent unsegmented
+ *
+ * Takes into account whether the request would currently be sent in the
+ * compact form. A server with a compact request outstanding, or whose last
+ * compact request timed out recently, is sent the regular form. Only holds
+ * when the payload isn't compressed or delta encoded, which only happens when
+ * it makes the message shorter.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @param len      Length of the payload
+ * @return true if a set message with @p len bytes of payload is sent unsegmented
+ */
+bool bt_mesh_vendor_cli_set_unseg(struct bt_mesh_vendor_cli *cli,
+				  struct bt_mesh_msg_ctx *ctx, size_t len);
+
+/**
+ * @brief Enable or disable SET_UNACK batching
+ *
+ * While enabled, @ref bt_mesh_vendor_cli_set_unack packs payloads to the
+ * same destination into one Vendor_Set_Unack_Batch message. A batch is sent
+ * when it reaches @kconfig{CONFIG_BT_MESH_VENDOR_BATCH_SIZE} bytes or
+ * @kconfig{CONFIG_BT_MESH_VENDOR_BATCH_RECORDS} records, or after
+ * @kconfig{CONFIG_BT_MESH_VENDOR_BATCH_TIMEOUT} milliseconds. Pending
+ * batches are sent when batching is disabled.
+ *
+ * @param cli      Vendor Client model
+ * @param enable   Whether to batch SET_UNACK payloads
+ * @return 0 on success, -ENOTSUP if @kconfig{CONFIG_BT_MESH_VENDOR_BATCH} is
+ *         disabled, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_batch_enable(struct bt_mesh_vendor_cli *cli, bool enable);
+
+/**
+ * @brief Send all pending SET_UNACK batches now
+ *
+ * @param cli      Vendor Client model
+ * @return 0 on success, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_batch_flush(struct bt_mesh_vendor_cli *cli);
+
+/**
+ * @brief Start a stream of sequenced unacknowledged records
+ *
+ * Records sent with @ref bt_mesh_vendor_cli_stream_send go to the given
+ * destination, numbered from 0. The server passes every record to its set
+ * handler, like a Vendor_Set_Unack, and asks for the records it's missing
+ * with a Vendor_Stream_Nack. The client sends them again from a ring of the
+ * last @kconfig{CONFIG_BT_MESH_VENDOR_STREAM_RING_SIZE} bytes of records.
+ *
+ * Starting a stream ends the previous one, and records it kept for
+ * retransmission are dropped. Requires @kconfig{CONFIG_BT_MESH_VENDOR_STREAM}.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, or NULL to use the configured publish parameters
+ * @return 0 on success, -ENOTSUP if streaming is disabled
+ */
+int bt_mesh_vendor_cli_stream_start(struct bt_mesh_vendor_cli *cli,
+				    struct bt_mesh_msg_ctx *ctx);
+
+/**
+ * @brief Send a record on the stream
+ *
+ * Sends the record as a Vendor_Stream with the next sequence number, and
+ * keeps a copy in the retransmit ring, dropping the oldest records if it's
+ * full. Only the last @ref BT_MESH_VENDOR_STREAM_WINDOW records are kept.
+ *
+ * @param cli      Vendor Client model
+ * @param set      Record to send
+ * @return 0 on success, -ENOTCONN if no stream is started, -EMSGSIZE if the
+ *         record is longer than @ref BT_MESH_VENDOR_STREAM_DATA_MAXLEN or the
+ *         ring, -ENOTSUP if streaming is disabled, or negative error code
+ *         otherwise
+ */
+int bt_mesh_vendor_cli_stream_send(struct bt_mesh_vendor_cli *cli,
+				   const struct bt_mesh_vendor_set *set);
+
+/**
+ * @brief Stop the stream
+ *
+ * Drops the records kept for retransmission. Later Vendor_Stream_Nack
+ * messages for the stream are ignored.
+ *
+ * @param cli      Vendor Client model
+ * @return 0 on success, -ENOTSUP if streaming is disabled
+ */
+int bt_mesh_vendor_cli_stream_stop(struct bt_mesh_vendor_cli *cli);
+
+/**
+ * @brief Get the round trip time estimates of recently addressed servers
+ *
+ * With @kconfig{CONFIG_BT_MESH_VENDOR_CLI_RTT}, the client measures the round
+ * trip time of acknowledged requests to every unicast destination, and
+ * times requests out after the smoothed round trip time plus four times its
+ * variation. Requests without a response are sent again up to
+ * @kconfig{CONFIG_BT_MESH_VENDOR_CLI_RETRIES} times, doubling the timeout
+ * every time.
+ *
+ * @param cli      Vendor Client model
+ * @param entries  Array to copy the estimates to, most recently used first
+ * @param max      Number of entries in @p entries
+ * @return Number of entries copied, or -ENOTSUP if round trip time
+ *         estimation is disabled
+ */
+int bt_mesh_vendor_cli_rtt_get(struct bt_mesh_vendor_cli *cli,
+			       struct bt_mesh_vendor_cli_rtt *entries, size_t max);
+
+/**
+ * @brief Set the callback for when the client can send again
+ *
+ * With @kconfig{CONFIG_BT_MESH_VENDOR_PACE}, messages are sent at a rate
+ * that adapts to send failures, request timeouts and round trip times.
+ * Messages beyond the rate wait in a queue of
+ * @kconfig{CONFIG_BT_MESH_VENDOR_PACE_QUEUE_LEN} messages, and are refused
+ * with -EAGAIN when it's full. The callback is called once the queue has
+ * drained after a message was refused.
+ *
+ * @param cli      Vendor Client model
+ * @param ready    Callback, or NULL to remove it
+ * @return 0 on success, -ENOTSUP if pacing is disabled
+ */
+int bt_mesh_vendor_cli_pace_ready_set(struct bt_mesh_vendor_cli *cli,
+				      void (*ready)(struct bt_mesh_vendor_cli *cli));
+
+/**
+ * @brief Get the state of the send pacer
+ *
+ * @param cli      Vendor Client model
+ * @param status   Pacer state to fill
+ * @return 0 on success, -ENOTSUP if pacing is disabled
+ */
+int bt_mesh_vendor_cli_pace_get(struct bt_mesh_vendor_cli *cli,
+				struct bt_mesh_vendor_cli_pace_status *status);
+
+/**
+ * @brief Send a payload of arbitrary size as a bulk transfer
+ *
+ * The payload is split into chunks of @kconfig{CONFIG_BT_MESH_VENDOR_BULK_CHUNK_SIZE}
+ * bytes. Up to @kconfig{CONFIG_BT_MESH_VENDOR_BULK_WINDOW} chunks are kept in
+ * flight, and only the chunks the server reports missing are sent again. The
+ * server verifies a CRC-32 of the complete payload before reporting success.
+ *
+ * This call blocks until the transfer completes or fails.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, must have a unicast destination
+ * @param data     Payload to send
+ * @param len      Length of the payload
+ * @return 0 on success, -EBADMSG if the server reported a checksum mismatch,
+ *         -ECONNREFUSED if the server rejected the transfer, -ETIMEDOUT if the
+ *         server stopped responding, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_bulk_send(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const uint8_t *data, size_t len);
+
+/**
+ * @brief Get a histogram from a node
+ *
+ * Sends a Vendor_Stats_Get and waits for the Vendor_Stats_Status. Only one
+ * statistics request can be outstanding per client.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, must have a unicast destination
+ * @param hist     Histogram to get
+ * @param buckets  Array to store the bucket counts in
+ * @return 0 on success, -ENOENT if the node doesn't keep statistics,
+ *         -ENOTSUP if @kconfig{CONFIG_BT_MESH_VENDOR_STATS} is disabled,
+ *         -EBUSY if another statistics request is outstanding, or negative
+ *         error code otherwise
+ */
+int bt_mesh_vendor_cli_stats_hist_get(struct bt_mesh_vendor_cli *cli,
+				      struct bt_mesh_msg_ctx *ctx,
+				      enum bt_mesh_vendor_stats_hist hist,
+				      uint32_t buckets[BT_MESH_VENDOR_STATS_BUCKETS]);
+
+/**
+ * @brief Get the counters of an opcode from a node
+ *
+ * Sends a Vendor_Stats_Get and waits for the Vendor_Stats_Status. Only one
+ * statistics request can be outstanding per client.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, must have a unicast destination
+ * @param op       Vendor opcode to get the counters of
+ * @param counters Counters to fill
+ * @return 0 on success, -ENOENT if the node doesn't keep statistics or
+ *         @p op has no counters, -ENOTSUP if
+ *         @kconfig{CONFIG_BT_MESH_VENDOR_STATS} is disabled, -EBUSY if another
+ *         statistics request is outstanding, or negative error code otherwise
+ */
+int bt_mesh_vendor_cli_stats_op_get(struct bt_mesh_vendor_cli *cli,
+				    struct bt_mesh_msg_ctx *ctx, uint32_t op,
+				    struct bt_mesh_vendor_stats_op *counters);
+
+/**
+ * @brief Get the counters of a vendor command from a node
+ *
+ * Sends a Vendor_Stats_Get and waits for the Vendor_Stats_Status. Only one
+ * statistics request can be outstanding per client.
+ *
+ * @param cli      Vendor Client model
+ * @param ctx      Message context, must have a unicast destination
+ * @param cmd      Command ID to get the counters of
+ * @param counters Counters to fill
+ * @return 0 on success, -ENOENT if the node doesn't keep statistics for
+ *         @p cmd, -ENOTSUP if @kconfig{CONFIG_BT_MESH_VENDOR_STATS} is
+ *         disabled, -EBUSY if another statistics request is outstanding, or
+ *         negative error code otherwise
+ */
+int bt_mesh_vendor_cli_stats_cmd_get(struct bt_mesh_vendor_cli *cli,
+				     struct bt_mesh_msg_ctx *ctx, uint8_t cmd,
+				     struct bt_mesh_vendor_stats_cmd *counters);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,8 @@
 #define VND_COMMON_H__
 
 #include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/crc.h>
+#include "vnd_schema.h"
 
 /**
  * @brief Vendor Model common definitions
@@ -27,15 +29,306 @@
 #define BT_MESH_VENDOR_OP_SET_UNACK   BT_MESH_MODEL_OP_3(0x11, BT_COMP_ID_VENDOR)
 #define BT_MESH_VENDOR_OP_GET 	      BT_MESH_MODEL_OP_3(0x12, BT_COMP_ID_VENDOR)
 #define BT_MESH_VENDOR_OP_STATUS      BT_MESH_MODEL_OP_3(0x13, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_BULK_START  BT_MESH_MODEL_OP_3(0x14, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_BULK_CHUNK  BT_MESH_MODEL_OP_3(0x15, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_BULK_ACK    BT_MESH_MODEL_OP_3(0x16, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_SET_Z       BT_MESH_MODEL_OP_3(0x17, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_SET_UNACK_Z BT_MESH_MODEL_OP_3(0x18, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_STATUS_Z    BT_MESH_MODEL_OP_3(0x19, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_CAPS_GET    BT_MESH_MODEL_OP_3(0x1a, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_CAPS_STATUS BT_MESH_MODEL_OP_3(0x1b, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_GET_COND    BT_MESH_MODEL_OP_3(0x1c, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_NOT_MODIFIED BT_MESH_MODEL_OP_3(0x1d, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_SET_DELTA   BT_MESH_MODEL_OP_3(0x1e, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_DELTA_STALE BT_MESH_MODEL_OP_3(0x1f, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_SET_UNACK_BATCH BT_MESH_MODEL_OP_3(0x20, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_SET_C       BT_MESH_MODEL_OP_3(0x21, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_STATUS_C    BT_MESH_MODEL_OP_3(0x22, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_STATS_GET   BT_MESH_MODEL_OP_3(0x23, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_STATS_STATUS BT_MESH_MODEL_OP_3(0x24, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_CMD         BT_MESH_MODEL_OP_3(0x25, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_CMD_STATUS  BT_MESH_MODEL_OP_3(0x26, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_STREAM      BT_MESH_MODEL_OP_3(0x27, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_STREAM_NACK BT_MESH_MODEL_OP_3(0x28, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_GET_PAGE    BT_MESH_MODEL_OP_3(0x29, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_PAGE_STATUS BT_MESH_MODEL_OP_3(0x2a, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_KV_GET      BT_MESH_MODEL_OP_3(0x2b, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_KV_STATUS   BT_MESH_MODEL_OP_3(0x2c, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_KV_SET      BT_MESH_MODEL_OP_3(0x2d, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_KV_SET_UNACK BT_MESH_MODEL_OP_3(0x2e, BT_COMP_ID_VENDOR)
+#define BT_MESH_VENDOR_OP_KV_SET_STATUS BT_MESH_MODEL_OP_3(0x2f, BT_COMP_ID_VENDOR)
 
-/* Maximum message length (excluding 3 byte opcode) is 377 bytes */
-#define BT_MESH_VENDOR_MSG_MAXLEN_SET    (377)
+/* Transaction ID, carried as the first byte of SET, GET and STATUS */
+#define BT_MESH_VENDOR_TID_LEN           (1)
 
-/* Maximum message length (excluding 3 byte opcode) is sizeof(bt_mesh_vendor_get), i.e. 2 bytes */
-#define BT_MESH_VENDOR_MSG_MAXLEN_GET    (2)
+/* Transaction ID of STATUS messages that don't answer a request, e.g. publications */
+#define BT_MESH_VENDOR_TID_NONE          (0)
 
-/* Status message max length (excluding 3 byte opcode) is 377 bytes */
-#define BT_MESH_VENDOR_MSG_MAXLEN_STATUS (377)
+/* Maximum data length (excluding 3 byte opcode and TID) is 376 bytes */
+#define BT_MESH_VENDOR_MSG_MAXLEN_SET    (376)
+
+/* Maximum message length (excluding 3 byte opcode) is the TID and sizeof(bt_mesh_vendor_get), i.e. 3 bytes */
+#define BT_MESH_VENDOR_MSG_MAXLEN_GET    (BT_MESH_VENDOR_TID_LEN + 2)
+
+/* Status data max length (excluding 3 byte opcode and TID) is 376 bytes */
+#define BT_MESH_VENDOR_MSG_MAXLEN_STATUS (376)
+
+/* Opcode and TID in front of the STATUS data */
+#define BT_MESH_VENDOR_STATUS_HDR_LEN                                          \
+	(BT_MESH_MODEL_OP_LEN(BT_MESH_VENDOR_OP_STATUS) + BT_MESH_VENDOR_TID_LEN)
+
+/* SET, GET and STATUS carry at least the TID */
+#define BT_MESH_VENDOR_MSG_MINLEN_SET    BT_MESH_VENDOR_TID_LEN
+#define BT_MESH_VENDOR_MSG_MINLEN_GET    BT_MESH_VENDOR_TID_LEN
+#define BT_MESH_VENDOR_MSG_MINLEN_STATUS BT_MESH_VENDOR_TID_LEN
+
+/* Conditional get is the TID, the version the client has (4) and the optional length (2) */
+#define BT_MESH_VENDOR_MSG_MINLEN_GET_COND   (BT_MESH_VENDOR_TID_LEN + 4)
+#define BT_MESH_VENDOR_MSG_MAXLEN_GET_COND   (BT_MESH_VENDOR_MSG_MINLEN_GET_COND + 2)
+
+/* Not modified only carries the TID */
+#define BT_MESH_VENDOR_MSG_LEN_NOT_MODIFIED  BT_MESH_VENDOR_TID_LEN
+
+/* Delta set is the TID, base version (4), new version (4) and new length (2), followed by
+ * ranges of changed bytes
+ */
+#define BT_MESH_VENDOR_MSG_MINLEN_SET_DELTA  (BT_MESH_VENDOR_TID_LEN + 10)
+
+/* Each delta range is an offset (2) and a length (1), followed by the new bytes */
+#define BT_MESH_VENDOR_DELTA_RANGE_HDR_LEN   (3)
+
+/* Delta stale only carries the TID */
+#define BT_MESH_VENDOR_MSG_LEN_DELTA_STALE   BT_MESH_VENDOR_TID_LEN
+
+/* Set unack batch is a sequence of records, each a length (1) followed by the data */
+#define BT_MESH_VENDOR_MSG_MINLEN_SET_UNACK_BATCH (1)
+
+/* Maximum data length of a record in a set unack batch */
+#define BT_MESH_VENDOR_BATCH_RECORD_MAXLEN   (UINT8_MAX)
+
+/* Largest access payload, including the opcode, sent in a single unsegmented PDU */
+#define BT_MESH_VENDOR_UNSEG_MAXLEN          (11)
+
+/* Compact set and compact status carry the data only. The response is matched to the request
+ * by address, so the client has at most one compact request per server outstanding.
+ */
+#define BT_MESH_VENDOR_MSG_MAXLEN_SET_C                                        \
+	(BT_MESH_VENDOR_UNSEG_MAXLEN - BT_MESH_MODEL_OP_LEN(BT_MESH_VENDOR_OP_SET_C))
+
+/* Caps get and caps status carry the capabilities of the sender */
+#define BT_MESH_VENDOR_MSG_LEN_CAPS          (1)
+
+/* Capability bit: the node accepts the compressed SET, SET_UNACK and STATUS opcodes */
+#define BT_MESH_VENDOR_CAP_LZ                BIT(0)
+
+/* Stats get is the kind of statistics (1) and the histogram or opcode (1) */
+#define BT_MESH_VENDOR_MSG_LEN_STATS_GET     (2)
+
+/* Stats status repeats the stats get, followed by the values in little endian, 4 bytes each.
+ * Only the stats get is sent back if the node doesn't have the requested statistics.
+ */
+#define BT_MESH_VENDOR_MSG_MINLEN_STATS_STATUS BT_MESH_VENDOR_MSG_LEN_STATS_GET
+
+/* Command is the TID and the command ID (1), followed by the command parameters */
+#define BT_MESH_VENDOR_MSG_MINLEN_CMD        (BT_MESH_VENDOR_TID_LEN + 1)
+
+/* Command status is the TID, the command ID (1) and the result (1), followed by the response
+ * parameters
+ */
+#define BT_MESH_VENDOR_MSG_MINLEN_CMD_STATUS (BT_MESH_VENDOR_TID_LEN + 2)
+
+/* Maximum parameter length of a command, so it fits in as many segments as a SET */
+#define BT_MESH_VENDOR_CMD_PARAMS_MAXLEN                                       \
+	(BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET - BT_MESH_VENDOR_MSG_MINLEN_CMD)
+
+/* Maximum parameter length of a command status */
+#define BT_MESH_VENDOR_CMD_RSP_MAXLEN                                          \
+	(BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET -               \
+	 BT_MESH_VENDOR_MSG_MINLEN_CMD_STATUS)
+
+/* Bulk start is transfer ID (1), total length (4), chunk size (1) and CRC-32 (4) */
+#define BT_MESH_VENDOR_MSG_LEN_BULK_START    (10)
+
+/* Bulk chunk is transfer ID (1), chunk index (2) and at least one byte of data */
+#define BT_MESH_VENDOR_MSG_MINLEN_BULK_CHUNK (4)
+
+/* Bulk ack is transfer ID (1), status (1), base chunk index (2) and bitmap (4) */
+#define BT_MESH_VENDOR_MSG_LEN_BULK_ACK      (8)
+
+/* Flag in the bulk chunk index requesting a Vendor_Bulk_Ack from the server */
+#define BT_MESH_VENDOR_BULK_ACK_REQ          BIT(15)
+
+/* Maximum number of chunks in a single bulk transfer */
+#define BT_MESH_VENDOR_BULK_CHUNK_COUNT_MAX  (BT_MESH_VENDOR_BULK_ACK_REQ - 1)
+
+/** Bulk transfer status, carried in the Vendor_Bulk_Ack message */
+enum bt_mesh_vendor_bulk_status {
+	/** Transfer is ongoing */
+	BT_MESH_VENDOR_BULK_IN_PROGRESS,
+	/** All chunks received and the checksum matches */
+	BT_MESH_VENDOR_BULK_COMPLETE,
+	/** All chunks received, but the checksum does not match */
+	BT_MESH_VENDOR_BULK_CRC_ERROR,
+	/** Server is unable or unwilling to receive the transfer */
+	BT_MESH_VENDOR_BULK_REJECTED,
+};
+
+/* Vendor_Bulk_Start parameters */
+#define BT_MESH_VENDOR_BULK_START_FIELDS(X) \
+	X(u8, id)                           \
+	X(le32, len)                        \
+	X(u8, chunk_size)                   \
+	X(le32, crc)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(bt_mesh_vendor_bulk_start, BT_MESH_VENDOR_BULK_START_FIELDS);
+BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(bt_mesh_vendor_bulk_start) ==
+	     BT_MESH_VENDOR_MSG_LEN_BULK_START);
+
+/* Vendor_Bulk_Ack parameters */
+#define BT_MESH_VENDOR_BULK_ACK_FIELDS(X) \
+	X(u8, id)                         \
+	X(u8, status)                     \
+	X(le16, base)                     \
+	X(le32, bitmap)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(bt_mesh_vendor_bulk_ack, BT_MESH_VENDOR_BULK_ACK_FIELDS);
+BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(bt_mesh_vendor_bulk_ack) ==
+	     BT_MESH_VENDOR_MSG_LEN_BULK_ACK);
+
+/* Stream record is stream ID (1) and sequence number (2), followed by the data */
+#define BT_MESH_VENDOR_MSG_MINLEN_STREAM     (3)
+
+/* Maximum data length of a stream record, so it fits in as many segments as a SET */
+#define BT_MESH_VENDOR_STREAM_DATA_MAXLEN                                      \
+	(BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET - BT_MESH_VENDOR_MSG_MINLEN_STREAM)
+
+/* Stream nack is stream ID (1), next sequence number (2) and missing records bitmap (4) */
+#define BT_MESH_VENDOR_MSG_LEN_STREAM_NACK   (7)
+
+/* Number of records below the next sequence number a Vendor_Stream_Nack can ask for */
+#define BT_MESH_VENDOR_STREAM_WINDOW         (32)
+
+/* Vendor_Stream header, in front of the record data */
+#define BT_MESH_VENDOR_STREAM_HDR_FIELDS(X) \
+	X(u8, id)                           \
+	X(le16, seq)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(bt_mesh_vendor_stream_hdr, BT_MESH_VENDOR_STREAM_HDR_FIELDS);
+BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(bt_mesh_vendor_stream_hdr) ==
+	     BT_MESH_VENDOR_MSG_MINLEN_STREAM);
+
+/* Vendor_Stream_Nack parameters. Bit n of missing is record next - 1 - n. */
+#define BT_MESH_VENDOR_STREAM_NACK_FIELDS(X) \
+	X(u8, id)                            \
+	X(le16, next)                        \
+	X(le32, missing)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(bt_mesh_vendor_stream_nack, BT_MESH_VENDOR_STREAM_NACK_FIELDS);
+BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(bt_mesh_vendor_stream_nack) ==
+	     BT_MESH_VENDOR_MSG_LEN_STREAM_NACK);
+
+/* Get page is the TID, the offset (4) and the maximum length (2) of the page */
+#define BT_MESH_VENDOR_MSG_LEN_GET_PAGE      (BT_MESH_VENDOR_TID_LEN + 6)
+
+/* Page status is the TID, the result (1) and the total length of the dataset (4), followed by
+ * the page data
+ */
+#define BT_MESH_VENDOR_MSG_MINLEN_PAGE_STATUS (BT_MESH_VENDOR_TID_LEN + 5)
+
+/* Maximum data length of a page, so it fits in as many segments as a SET */
+#define BT_MESH_VENDOR_PAGE_DATA_MAXLEN                                        \
+	(BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET -               \
+	 BT_MESH_VENDOR_MSG_MINLEN_PAGE_STATUS)
+
+/* Vendor_Get_Page parameters */
+#define BT_MESH_VENDOR_GET_PAGE_FIELDS(X) \
+	X(u8, tid)                        \
+	X(le32, offset)                   \
+	X(le16, len)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(bt_mesh_vendor_get_page, BT_MESH_VENDOR_GET_PAGE_FIELDS);
+BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(bt_mesh_vendor_get_page) ==
+	     BT_MESH_VENDOR_MSG_LEN_GET_PAGE);
+
+/* Vendor_Page_Status header, in front of the page data */
+#define BT_MESH_VENDOR_PAGE_HDR_FIELDS(X) \
+	X(u8, tid)                        \
+	X(u8, result)                     \
+	X(le32, total)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(bt_mesh_vendor_page_hdr, BT_MESH_VENDOR_PAGE_HDR_FIELDS);
+BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(bt_mesh_vendor_page_hdr) ==
+	     BT_MESH_VENDOR_MSG_MINLEN_PAGE_STATUS);
+
+/** Page result, carried in the Vendor_Page_Status message */
+enum bt_mesh_vendor_page_result {
+	/** Page read, the data follows */
+	BT_MESH_VENDOR_PAGE_SUCCESS,
+	/** Server has no page_read handler */
+	BT_MESH_VENDOR_PAGE_NOT_SUPPORTED,
+	/** Offset is past the end of the dataset */
+	BT_MESH_VENDOR_PAGE_OUT_OF_RANGE,
+	/** Page read handler returned an error */
+	BT_MESH_VENDOR_PAGE_FAILED,
+};
+
+/* Each key-value record is the key (1) and the value length (1), followed by the value. The
+ * length is 0 in a status if the server doesn't have the key.
+ */
+#define BT_MESH_VENDOR_KV_REC_HDR_LEN        (2)
+
+/* Maximum length of a value, set by the one byte length of its record */
+#define BT_MESH_VENDOR_KV_VALUE_MAXLEN       (UINT8_MAX)
+
+/* Key-value get is the TID, followed by at least one key (1) */
+#define BT_MESH_VENDOR_MSG_MINLEN_KV_GET     (BT_MESH_VENDOR_TID_LEN + 1)
+
+/* Key-value status is the TID, followed by records. Also published with
+ * BT_MESH_VENDOR_TID_NONE when keys change.
+ */
+#define BT_MESH_VENDOR_MSG_MINLEN_KV_STATUS  BT_MESH_VENDOR_TID_LEN
+
+/* Key-value set is the TID, followed by at least one record */
+#define BT_MESH_VENDOR_MSG_MINLEN_KV_SET     (BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_KV_REC_HDR_LEN)
+
+/* Key-value set unack carries at least one record, without the TID */
+#define BT_MESH_VENDOR_MSG_MINLEN_KV_SET_UNACK BT_MESH_VENDOR_KV_REC_HDR_LEN
+
+/* Key-value set status is the TID, followed by the keys that weren't written (1 each) */
+#define BT_MESH_VENDOR_MSG_MINLEN_KV_SET_STATUS BT_MESH_VENDOR_TID_LEN
+
+/* Key-value record header, in front of the value */
+#define BT_MESH_VENDOR_KV_REC_FIELDS(X) \
+	X(u8, key)                      \
+	X(u8, len)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(bt_mesh_vendor_kv_rec_hdr, BT_MESH_VENDOR_KV_REC_FIELDS);
+BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(bt_mesh_vendor_kv_rec_hdr) ==
+	     BT_MESH_VENDOR_KV_REC_HDR_LEN);
+
+/** Command result, carried in the Vendor_Cmd_Status message */
+enum bt_mesh_vendor_cmd_result {
+	/** Command handled, the response parameters follow */
+	BT_MESH_VENDOR_CMD_SUCCESS,
+	/** Server has no handler for the command ID */
+	BT_MESH_VENDOR_CMD_UNKNOWN,
+	/** Parameter length is outside the range the command accepts */
+	BT_MESH_VENDOR_CMD_INVALID_LEN,
+	/** Command handler returned an error */
+	BT_MESH_VENDOR_CMD_FAILED,
+};
+
+/** Vendor model capabilities of a peer node */
+struct bt_mesh_vendor_peer {
+	/** Unicast address of the peer, or BT_MESH_ADDR_UNASSIGNED if the entry is free */
+	uint16_t addr;
+	/** Capability bits of the peer, zero until the peer has answered */
+	uint8_t caps;
+	/** Whether the peer was asked for its capabilities and hasn't answered yet */
+	bool pending;
+	/** Uptime at which the peer was last asked, in milliseconds */
+	int64_t asked;
+};
 
 /**
  * @brief Vendor Status Message
@@ -44,15 +337,62 @@
  */
 struct bt_mesh_vendor_status {
 	struct net_buf_simple *buf;
+	/** Transaction ID of the request being answered, or @ref BT_MESH_VENDOR_TID_NONE */
+	uint8_t tid;
+	/** Whether the request was a compact Vendor_Set_C, answered by a
+	 *  Vendor_Status_C without the transaction ID
+	 */
+	bool compact;
+};
+
+/**
+ * @brief Vendor payload fragment
+ */
+struct bt_mesh_vendor_iov {
+	/** Fragment data */
+	const void *data;
+	/** Fragment length */
+	size_t len;
+};
+
+/**
+ * @brief Priority class of an outgoing client message
+ *
+ * With @kconfig{CONFIG_BT_MESH_VENDOR_PACE}, the client's send pacer serves
+ * queued urgent messages first and bulk messages last. The zero value is
+ * normal, so messages are normal unless they ask for another class.
+ */
+enum bt_mesh_vendor_prio {
+	/** Regular requests */
+	BT_MESH_VENDOR_PRIO_NORMAL,
+	/** Alarms and actuator commands, sent ahead of everything else */
+	BT_MESH_VENDOR_PRIO_URGENT,
+	/** Telemetry and other large data, sent when nothing else is waiting */
+	BT_MESH_VENDOR_PRIO_BULK,
+
+	BT_MESH_VENDOR_PRIO_COUNT,
 };
 
 /**
  * @brief Vendor Set Message
  *
  * This structure represents the set message sent to a vendor model server.
+ *
+ * When sending, the payload is either @c buf, or if @c buf is NULL, the
+ * fragments in @c iov sent back to back. Fragments are written directly into
+ * the outgoing message, without an intermediate buffer. Received messages
+ * always use @c buf.
  */
 struct bt_mesh_vendor_set {
 	struct net_buf_simple *buf;
+	/** Payload fragments, used when @c buf is NULL */
+	const struct bt_mesh_vendor_iov *iov;
+	/** Number of fragments in @c iov */
+	size_t iov_cnt;
+	/** Priority class the client sends the message at, see
+	 *  @ref bt_mesh_vendor_prio. Unused on receive.
+	 */
+	uint8_t prio;
 };
 
 /**
@@ -65,6 +405,39 @@ struct bt_mesh_vendor_get {
 	uint16_t length;
 };
 
+/**
+ * @brief Check whether a message is sent unsegmented
+ *
+ * Segmented messages take several advertisements and need transport layer
+ * acknowledgments. The mesh stack sends a message unsegmented if its access
+ * payload fits in one PDU and the message context doesn't ask for reliable
+ * sending.
+ *
+ * @param op       Opcode of the message
+ * @param len      Length of the message parameters
+ * @param send_rel Whether the message is sent with @c send_rel set
+ * @return true if the message is sent unsegmented
+ */
+static inline bool bt_mesh_vendor_msg_unseg(uint32_t op, size_t len, bool send_rel)
+{
+	return !send_rel && BT_MESH_MODEL_OP_LEN(op) + len <= BT_MESH_VENDOR_UNSEG_MAXLEN;
+}
+
+/**
+ * @brief Get the version of status data
+ *
+ * The version is the CRC-32 (IEEE) of the data, so client and server compute
+ * it independently and it never has to be sent along with the data. Empty
+ * data has version 0.
+ *
+ * @param buf Status data
+ * @return Version of the data
+ */
+static inline uint32_t bt_mesh_vendor_version(const struct net_buf_simple *buf)
+{
+	return crc32_ieee(buf->data, buf->len);
+}
+
 /** @} */
 
 #endif /* VND_COMMON_H__ */
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef VND_POOL_H__
+#define VND_POOL_H__
+
+#include <zephyr/bluetooth/mesh.h>
+#include "vnd_common.h"
+
+/**
+ * @brief Vendor model payload buffer pool
+ * @defgroup bt_mesh_vendor_pool Vendor model payload buffer pool
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of a pool buffer, large enough for any vendor model message including the TransMIC */
+#define BT_MESH_VENDOR_POOL_BUF_SIZE                                           \
+	BT_MESH_MODEL_BUF_LEN(BT_MESH_VENDOR_OP_SET,                           \
+			      BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET)
+
+/** Pool usage statistics */
+struct bt_mesh_vendor_pool_stats {
+	/** Buffers currently in use */
+	uint32_t used;
+	/** Highest number of buffers in use at the same time */
+	uint32_t max_used;
+	/** Total number of buffers in the pool */
+	uint32_t total;
+	/** Allocations that failed because the pool was empty */
+	uint32_t failed;
+};
+
+/**
+ * @brief Take a buffer from the pool
+ *
+ * Never blocks, so it can be used from the Bluetooth receive thread.
+ *
+ * @param buf Buffer to initialize over the pool memory, with zero length
+ * @return 0 on success, or -ENOMEM if the pool is empty
+ */
+int bt_mesh_vendor_pool_buf_get(struct net_buf_simple *buf);
+
+/**
+ * @brief Return a buffer to the pool
+ *
+ * @param buf Buffer taken with @ref bt_mesh_vendor_pool_buf_get
+ */
+void bt_mesh_vendor_pool_buf_put(struct net_buf_simple *buf);
+
+/**
+ * @brief Get pool usage statistics
+ *
+ * @param stats Statistics to fill
+ */
+void bt_mesh_vendor_pool_stats_get(struct bt_mesh_vendor_pool_stats *stats);
+
+/**
+ * @brief Log pool usage and stack high-water marks
+ *
+ * The stack usage of every thread that has taken a pool buffer is reported,
+ * which includes the Bluetooth receive thread and the workqueues the vendor
+ * models run on. Stack usage requires
+ * @kconfig{CONFIG_BT_MESH_VENDOR_MEM_REPORT}.
+ */
+void bt_mesh_vendor_mem_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* VND_POOL_H__ */
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef VND_SCHEMA_H__
+#define VND_SCHEMA_H__
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+/**
+ * @brief Vendor message schemas
+ * @defgroup bt_mesh_vendor_schema Vendor message schemas
+ * @{
+ *
+ * A schema lists the fields of a message once, as an X-macro taking the
+ * field type, the field name and, for some types, an argument:
+ *
+ * @code
+ * #define MY_MSG_FIELDS(X)  \
+ *	X(u8, mode)       \
+ *	X(bits, on, 1)    \
+ *	X(bits, level, 7) \
+ *	X(varint, delay)  \
+ *	X(bytes, tag, 4)
+ *
+ * BT_MESH_VENDOR_SCHEMA_DEFINE(my_msg, MY_MSG_FIELDS);
+ * @endcode
+ *
+ * This defines @c struct @c my_msg with one member per field, and
+ * @c my_msg_encode() and @c my_msg_decode() that pack and unpack it in the
+ * order of the fields, without any padding or tags.
+ *
+ * Field types:
+ * - @c u8, @c le16, @c le32: Little endian integers of 1, 2 and 4 bytes.
+ * - @c varint: @c uint32_t in 1 to 5 bytes, 7 bits per byte, least
+ *   significant first. Small values take a single byte.
+ * - @c bits: @c uint32_t of the given width, from 1 to 32 bits.
+ *   Consecutive bit fields are packed together, least significant bit
+ *   first, and the last one is padded to a whole byte.
+ * - @c bytes: Byte array of the given length.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Writer and reader state. Bit fields are collected in acc until they fill
+ * a byte, and any other field starts on the next whole byte.
+ */
+struct _bt_mesh_vendor_schema_wr {
+	uint8_t *p;
+	uint64_t acc;
+	uint8_t nbits;
+};
+
+struct _bt_mesh_vendor_schema_rd {
+	const uint8_t *p;
+	const uint8_t *end;
+	uint64_t acc;
+	uint8_t nbits;
+	bool err;
+};
+
+static inline void _bt_mesh_vendor_schema_wr_flush(struct _bt_mesh_vendor_schema_wr *wr)
+{
+	if (wr->nbits) {
+		*wr->p++ = wr->acc;
+		wr->acc = 0;
+		wr->nbits = 0;
+	}
+}
+
+static inline void _bt_mesh_vendor_schema_put_u8(struct _bt_mesh_vendor_schema_wr *wr,
+						 uint8_t val)
+{
+	_bt_mesh_vendor_schema_wr_flush(wr);
+	*wr->p++ = val;
+}
+
+static inline void _bt_mesh_vendor_schema_put_le16(struct _bt_mesh_vendor_schema_wr *wr,
+						   uint16_t val)
+{
+	_bt_mesh_vendor_schema_wr_flush(wr);
+	sys_put_le16(val, wr->p);
+	wr->p += 2;
+}
+
+static inline void _bt_mesh_vendor_schema_put_le32(struct _bt_mesh_vendor_schema_wr *wr,
+						   uint32_t val)
+{
+	_bt_mesh_vendor_schema_wr_flush(wr);
+	sys_put_le32(val, wr->p);
+	wr->p += 4;
+}
+
+static inline void _bt_mesh_vendor_schema_put_varint(struct _bt_mesh_vendor_schema_wr *wr,
+						     uint32_t val)
+{
+	_bt_mesh_vendor_schema_wr_flush(wr);
+
+	while (val >= 0x80) {
+		*wr->p++ = (val & 0x7f) | 0x80;
+		val >>= 7;
+	}
+
+	*wr->p++ = val;
+}
+
+static inline void _bt_mesh_vendor_schema_put_bits(struct _bt_mesh_vendor_schema_wr *wr,
+						   uint32_t val, uint8_t width)
+{
+	wr->acc |= (uint64_t)(val & BIT64_MASK(width)) << wr->nbits;
+	wr->nbits += width;
+
+	while (wr->nbits >= 8) {
+		*wr->p++ = wr->acc;
+		wr->acc >>= 8;
+		wr->nbits -= 8;
+	}
+}
+
+static inline void _bt_mesh_vendor_schema_put_bytes(struct _bt_mesh_vendor_schema_wr *wr,
+						    const uint8_t *val, size_t len)
+{
+	_bt_mesh_vendor_schema_wr_flush(wr);
+	memcpy(wr->p, val, len);
+	wr->p += len;
+}
+
+/* Start a field of len bytes on a whole byte. Returns false and marks the
+ * message as invalid if it's too short.
+ */
+static inline bool _bt_mesh_vendor_schema_rd_take(struct _bt_mesh_vendor_schema_rd *rd,
+						  size_t len)
+{
+	rd->acc = 0;
+	rd->nbits = 0;
+
+	if ((size_t)(rd->end - rd->p) < len) {
+		rd->err = true;
+		return false;
+	}
+
+	return true;
+}
+
+static inline void _bt_mesh_vendor_schema_get_u8(struct _bt_mesh_vendor_schema_rd *rd,
+						 uint8_t *val)
+{
+	if (_bt_mesh_vendor_schema_rd_take(rd, 1)) {
+		*val = *rd->p++;
+	}
+}
+
+static inline void _bt_mesh_vendor_schema_get_le16(struct _bt_mesh_vendor_schema_rd *rd,
+						   uint16_t *val)
+{
+	if (_bt_mesh_vendor_schema_rd_take(rd, 2)) {
+		*val = sys_get_le16(rd->p);
+		rd->p += 2;
+	}
+}
+
+static inline void _bt_mesh_vendor_schema_get_le32(struct _bt_mesh_vendor_schema_rd *rd,
+						   uint32_t *val)
+{
+	if (_bt_mesh_vendor_schema_rd_take(rd, 4)) {
+		*val = sys_get_le32(rd->p);
+		rd->p += 4;
+	}
+}
+
+static inline void _bt_mesh_vendor_schema_get_varint(struct _bt_mesh_vendor_schema_rd *rd,
+						     uint32_t *val)
+{
+	uint32_t v = 0;
+
+	/* The fifth byte holds the top 4 bits, anything longer is invalid */
+	for (int shift = 0; shift < 35; shift += 7) {
+		uint8_t b;
+
+		if (!_bt_mesh_vendor_schema_rd_take(rd, 1)) {
+			return;
+		}
+
+		b = *rd->p++;
+		v |= (uint32_t)(b & 0x7f) << shift;
+
+		if (!(b & 0x80)) {
+			*val = v;
+			return;
+		}
+	}
+
+	rd->err = true;
+}
+
+static inline void _bt_mesh_vendor_schema_get_bits(struct _bt_mesh_vendor_schema_rd *rd,
+						   uint32_t *val, uint8_t width)
+{
+	while (rd->nbits < width) {
+		if (rd->p == rd->end) {
+			rd->err = true;
+			return;
+		}
+
+		rd->acc |= (uint64_t)*rd->p++ << rd->nbits;
+		rd->nbits += 8;
+	}
+
+	*val = rd->acc & BIT64_MASK(width);
+	rd->acc >>= width;
+	rd->nbits -= width;
+}
+
+static inline void _bt_mesh_vendor_schema_get_bytes(struct _bt_mesh_vendor_schema_rd *rd,
+						    uint8_t *val, size_t len)
+{
+	if (_bt_mesh_vendor_schema_rd_take(rd, len)) {
+		memcpy(val, rd->p, len);
+		rd->p += len;
+	}
+}
+
+/* Per field type: C type, array dimension, largest encoded length and checks */
+#define _BT_MESH_VENDOR_SCHEMA_CTYPE_u8         uint8_t
+#define _BT_MESH_VENDOR_SCHEMA_CTYPE_le16       uint16_t
+#define _BT_MESH_VENDOR_SCHEMA_CTYPE_le32       uint32_t
+#define _BT_MESH_VENDOR_SCHEMA_CTYPE_varint     uint32_t
+#define _BT_MESH_VENDOR_SCHEMA_CTYPE_bits       uint32_t
+#define _BT_MESH_VENDOR_SCHEMA_CTYPE_bytes      uint8_t
+
+#define _BT_MESH_VENDOR_SCHEMA_DIM_u8()
+#define _BT_MESH_VENDOR_SCHEMA_DIM_le16()
+#define _BT_MESH_VENDOR_SCHEMA_DIM_le32()
+#define _BT_MESH_VENDOR_SCHEMA_DIM_varint()
+#define _BT_MESH_VENDOR_SCHEMA_DIM_bits(_width)
+#define _BT_MESH_VENDOR_SCHEMA_DIM_bytes(_len)  [_len]
+
+#define _BT_MESH_VENDOR_SCHEMA_MAXLEN_u8()         1
+#define _BT_MESH_VENDOR_SCHEMA_MAXLEN_le16()       2
+#define _BT_MESH_VENDOR_SCHEMA_MAXLEN_le32()       4
+#define _BT_MESH_VENDOR_SCHEMA_MAXLEN_varint()     5
+#define _BT_MESH_VENDOR_SCHEMA_MAXLEN_bits(_width) DIV_ROUND_UP(_width, 8)
+#define _BT_MESH_VENDOR_SCHEMA_MAXLEN_bytes(_len)  (_len)
+
+#define _BT_MESH_VENDOR_SCHEMA_CHECK_u8(_field)
+#define _BT_MESH_VENDOR_SCHEMA_CHECK_le16(_field)
+#define _BT_MESH_VENDOR_SCHEMA_CHECK_le32(_field)
+#define _BT_MESH_VENDOR_SCHEMA_CHECK_varint(_field)
+#define _BT_MESH_VENDOR_SCHEMA_CHECK_bits(_field, _width)                       \
+	BUILD_ASSERT((_width) >= 1 && (_width) <= 32,                          \
+		     "Bit field " #_field " must be 1 to 32 bits wide");
+#define _BT_MESH_VENDOR_SCHEMA_CHECK_bytes(_field, _len)                        \
+	BUILD_ASSERT((_len) >= 1, "Byte field " #_field " must not be empty");
+
+/* X-macro callbacks, each expanding one field of the schema */
+#define _BT_MESH_VENDOR_SCHEMA_MEMBER(_type, _field, ...)                       \
+	_BT_MESH_VENDOR_SCHEMA_CTYPE_##_type _field                            \
+		_BT_MESH_VENDOR_SCHEMA_DIM_##_type(__VA_ARGS__);
+#define _BT_MESH_VENDOR_SCHEMA_MAXLEN(_type, _field, ...)                       \
+	+ _BT_MESH_VENDOR_SCHEMA_MAXLEN_##_type(__VA_ARGS__)
+#define _BT_MESH_VENDOR_SCHEMA_CHECK(_type, _field, ...)                        \
+	_BT_MESH_VENDOR_SCHEMA_CHECK_##_type(_field, ##__VA_ARGS__)
+#define _BT_MESH_VENDOR_SCHEMA_ENCODE(_type, _field, ...)                       \
+	_bt_mesh_vendor_schema_put_##_type(&wr, msg->_field, ##__VA_ARGS__);
+#define _BT_MESH_VENDOR_SCHEMA_DECODE(_type, _field, ...)                       \
+	_bt_mesh_vendor_schema_get_##_type(&rd, _BT_MESH_VENDOR_SCHEMA_REF_##_type(msg->_field), \
+					   ##__VA_ARGS__);
+
+#define _BT_MESH_VENDOR_SCHEMA_REF_u8(_val)     &(_val)
+#define _BT_MESH_VENDOR_SCHEMA_REF_le16(_val)   &(_val)
+#define _BT_MESH_VENDOR_SCHEMA_REF_le32(_val)   &(_val)
+#define _BT_MESH_VENDOR_SCHEMA_REF_varint(_val) &(_val)
+#define _BT_MESH_VENDOR_SCHEMA_REF_bits(_val)   &(_val)
+#define _BT_MESH_VENDOR_SCHEMA_REF_bytes(_val)  (_val)
+
+/** @endcond */
+
+/**
+ * @brief Largest encoded length of a message defined with
+ *        @ref BT_MESH_VENDOR_SCHEMA_DEFINE
+ *
+ * A compile time constant, for buffer sizes and build assertions.
+ *
+ * @param _name Name of the message
+ */
+#define BT_MESH_VENDOR_SCHEMA_MAXLEN(_name) (_##_name##_maxlen)
+
+/**
+ * @brief Define a message from a schema
+ *
+ * Defines @c struct @c _name and the functions
+ *
+ * - <tt>int _name_encode(struct net_buf_simple *buf, const struct _name *msg)</tt>,
+ *   which adds the message to @p buf. Returns -ENOBUFS if @p buf has less
+ *   than @ref BT_MESH_VENDOR_SCHEMA_MAXLEN bytes of tailroom.
+ * - <tt>int _name_decode(struct net_buf_simple *buf, struct _name *msg)</tt>,
+ *   which pulls the message from @p buf. Returns -EINVAL if @p buf is too
+ *   short or a varint is longer than 5 bytes, and leaves @p buf untouched.
+ *
+ * The largest encoded length is checked against
+ * @ref BT_MESH_VENDOR_MSG_MAXLEN_SET at build time.
+ *
+ * @param _name   Name of the message
+ * @param _fields Schema X-macro, see @ref bt_mesh_vendor_schema
+ */
+#define BT_MESH_VENDOR_SCHEMA_DEFINE(_name, _fields)                            \
+	struct _name {                                                         \
+		_fields(_BT_MESH_VENDOR_SCHEMA_MEMBER)                         \
+	};                                                                     \
+	enum { _##_name##_maxlen = 0 _fields(_BT_MESH_VENDOR_SCHEMA_MAXLEN) }; \
+	_fields(_BT_MESH_VENDOR_SCHEMA_CHECK)                                  \
+	BUILD_ASSERT(BT_MESH_VENDOR_SCHEMA_MAXLEN(_name) <=                    \
+		     BT_MESH_VENDOR_MSG_MAXLEN_SET,                            \
+		     "Message " #_name " doesn't fit in a vendor message");    \
+	static inline int _name##_encode(struct net_buf_simple *buf,           \
+					 const struct _name *msg)              \
+	{                                                                      \
+		struct _bt_mesh_vendor_schema_wr wr = {                        \
+			.p = net_buf_simple_tail(buf),                         \
+		};                                                             \
+									       \
+		if (net_buf_simple_tailroom(buf) <                             \
+		    BT_MESH_VENDOR_SCHEMA_MAXLEN(_name)) {                     \
+			return -ENOBUFS;                                       \
+		}                                                              \
+									       \
+		_fields(_BT_MESH_VENDOR_SCHEMA_ENCODE)                         \
+		_bt_mesh_vendor_schema_wr_flush(&wr);                          \
+		net_buf_simple_add(buf, wr.p - net_buf_simple_tail(buf));      \
+									       \
+		return 0;                                                      \
+	}                                                                      \
+	static inline int _name##_decode(struct net_buf_simple *buf,           \
+					 struct _name *msg)                    \
+	{                                                                      \
+		struct _bt_mesh_vendor_schema_rd rd = {                        \
+			.p = buf->data,                                        \
+			.end = buf->data + buf->len,                           \
+		};                                                             \
+									       \
+		_fields(_BT_MESH_VENDOR_SCHEMA_DECODE)                         \
+									       \
+		if (rd.err) {                                                  \
+			return -EINVAL;                                        \
+		}                                                              \
+									       \
+		net_buf_simple_pull(buf, rd.p - buf->data);                    \
+									       \
+		return 0;                                                      \
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* VND_SCHEMA_H__ */
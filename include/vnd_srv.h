@@ -32,13 +32,189 @@ struct bt_mesh_vendor_srv;
 #define BT_MESH_VENDOR_SRV_INIT(_handlers)                                    \
 	{                                                                      \
 		.handlers = _handlers,                                         \
+		.pub = {                                                       \
+			.update = _bt_mesh_vendor_srv_update_handler,          \
+		},                                                             \
 	}
 
+/** Vendor command, an entry in the command table of a @ref bt_mesh_vendor_srv */
+struct bt_mesh_vendor_cmd {
+	/** @brief Command handler
+	 *
+	 * Called when a Vendor_Cmd with the command ID of this entry and a
+	 * valid parameter length is received. The response is always sent
+	 * immediately.
+	 *
+	 * @param srv    Vendor Server model
+	 * @param ctx    Message context
+	 * @param params Command parameters
+	 * @param rsp    Response parameters to send, at most
+	 *               @ref BT_MESH_VENDOR_CMD_RSP_MAXLEN bytes
+	 *
+	 * @return 0 on success, or negative error code to answer with
+	 *         @ref BT_MESH_VENDOR_CMD_FAILED and no parameters
+	 */
+	int (*const handler)(struct bt_mesh_vendor_srv *srv,
+			     struct bt_mesh_msg_ctx *ctx,
+			     struct net_buf_simple *params,
+			     struct net_buf_simple *rsp);
+	/** Minimum parameter length */
+	const uint16_t min_len;
+	/** Maximum parameter length */
+	const uint16_t max_len;
+};
+
+/** @def BT_MESH_VENDOR_CMD
+ *
+ * @brief Command table entry with a range of parameter lengths.
+ *
+ * The command table is indexed by command ID, so entries are placed with
+ * designated initializers, e.g. <tt>[MY_CMD_ID] = BT_MESH_VENDOR_CMD(...)</tt>.
+ * Unused IDs are left empty.
+ *
+ * @param[in] _handler Command handler.
+ * @param[in] _min_len Minimum parameter length.
+ * @param[in] _max_len Maximum parameter length.
+ */
+#define BT_MESH_VENDOR_CMD(_handler, _min_len, _max_len)                       \
+	{                                                                      \
+		.handler = _handler,                                           \
+		.min_len = _min_len,                                           \
+		.max_len = _max_len,                                           \
+	}
+
+/** @def BT_MESH_VENDOR_CMD_EXACT
+ *
+ * @brief Command table entry with a fixed parameter length.
+ *
+ * @param[in] _handler Command handler.
+ * @param[in] _len     Parameter length.
+ */
+#define BT_MESH_VENDOR_CMD_EXACT(_handler, _len) BT_MESH_VENDOR_CMD(_handler, _len, _len)
+
+/** Key of the key-value store, an entry in the key table of a @ref bt_mesh_vendor_srv */
+struct bt_mesh_vendor_kv {
+	/** Value, owned by the application */
+	void *const value;
+	/** Key. The table is sorted by key, so keys are found with a binary search. */
+	const uint8_t key;
+	/** Length of the value, from 1 to @ref BT_MESH_VENDOR_KV_VALUE_MAXLEN */
+	const uint8_t len;
+	/** Whether clients may write the value */
+	const bool writable;
+};
+
+/** @def BT_MESH_VENDOR_KV
+ *
+ * @brief Key table entry for a variable clients may read and write.
+ *
+ * The value is the whole variable, so its length is fixed by its type.
+ *
+ * @param[in] _key Key.
+ * @param[in] _var Variable holding the value.
+ */
+#define BT_MESH_VENDOR_KV(_key, _var)                                          \
+	{                                                                      \
+		.value = &(_var),                                              \
+		.key = _key,                                                   \
+		.len = sizeof(_var),                                           \
+		.writable = true,                                              \
+	}
+
+/** @def BT_MESH_VENDOR_KV_RO
+ *
+ * @brief Key table entry for a variable clients may only read.
+ *
+ * @param[in] _key Key.
+ * @param[in] _var Variable holding the value.
+ */
+#define BT_MESH_VENDOR_KV_RO(_key, _var)                                       \
+	{                                                                      \
+		.value = &(_var),                                              \
+		.key = _key,                                                   \
+		.len = sizeof(_var),                                           \
+	}
+
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+/** Stream reception state for one client */
+struct bt_mesh_vendor_srv_stream {
+	/** Uptime of the last record, to find the least recently active stream */
+	int64_t last;
+	/** Records missing below @c next, bit n is record next - 1 - n */
+	uint32_t missing;
+	/** Source address, or BT_MESH_ADDR_UNASSIGNED if the entry is free */
+	uint16_t src;
+	/** Network key index of the last record, to send nacks with */
+	uint16_t net_idx;
+	/** Application key index of the last record */
+	uint16_t app_idx;
+	/** Sequence number after the newest record received */
+	uint16_t next;
+	/** Stream ID */
+	uint8_t id;
+	/** Number of nacks sent since records last went missing */
+	uint8_t nacks;
+};
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+/** State of a request in the duplicate cache */
+enum bt_mesh_vendor_srv_dup_state {
+	/** The handler has the request, no response has been sent yet */
+	BT_MESH_VENDOR_SRV_DUP_PENDING,
+	/** The STATUS sent is in the entry */
+	BT_MESH_VENDOR_SRV_DUP_STATUS,
+	/** A NOT_MODIFIED was sent */
+	BT_MESH_VENDOR_SRV_DUP_NOT_MODIFIED,
+	/** The STATUS sent didn't fit in the entry */
+	BT_MESH_VENDOR_SRV_DUP_UNCACHED,
+};
+
+/** Recent acknowledged request of a client, and the response to it */
+struct bt_mesh_vendor_srv_dup {
+	/** Uptime at which the request was received, in milliseconds */
+	int64_t time;
+	/** Opcode of the request, SET for every kind of SET */
+	uint32_t op;
+	/** Digest of the request parameters, to tell requests apart when the TID wraps */
+	uint32_t digest;
+	/** Source address, or BT_MESH_ADDR_UNASSIGNED if the entry is free */
+	uint16_t src;
+	/** Length of the cached STATUS data */
+	uint16_t len;
+	/** Transaction ID of the request */
+	uint8_t tid;
+	/** See @ref bt_mesh_vendor_srv_dup_state */
+	uint8_t state;
+	/** Cached STATUS data */
+	uint8_t data[CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE_DATA_LEN];
+};
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+/** Last accepted SET payload from one client, the base of its delta SETs */
+struct bt_mesh_vendor_srv_base {
+	/** Address of the client, or BT_MESH_ADDR_UNASSIGNED if the entry is free */
+	uint16_t addr;
+	/** Length of the payload */
+	uint16_t len;
+	/** Version of the payload, see @ref bt_mesh_vendor_version */
+	uint32_t version;
+	/** Value of @c delta.seq when the entry was last used */
+	uint32_t seq;
+	/** Payload */
+	uint8_t data[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+};
+#endif
+
 /** Vendor Server Model Handler functions */
 struct bt_mesh_vendor_srv_handlers {
 	/** @brief Set callback
 	 *
-	 * Called when a Vendor_Set message is received
+	 * Called when a Vendor_Set message is received. Also called for
+	 * unacknowledged SETs, batch records and stream records, where the
+	 * response is never sent. Stream records the server asked for again
+	 * are passed on when they arrive, after newer records.
 	 *
 	 * @param srv    Vendor Server model
 	 * @param ctx    Message context
@@ -54,10 +230,12 @@ struct bt_mesh_vendor_srv_handlers {
 
 	/** @brief Get callback
 	 *
-	 * Called when a Vendor_Get message is received
+	 * Called when a Vendor_Get message is received, and to fill in the
+	 * status before it's published. The response to a publication must
+	 * be given immediately.
 	 *
 	 * @param srv    Vendor Server model
-	 * @param ctx    Message context
+	 * @param ctx    Message context, or NULL if the status is being published
 	 * @param get    Vendor get message parameters, can be NULL
 	 * @param rsp    Vendor status message to be sent
 	 *
@@ -67,6 +245,98 @@ struct bt_mesh_vendor_srv_handlers {
 			  struct bt_mesh_msg_ctx *ctx,
 			  const struct bt_mesh_vendor_get *get,
 			  struct bt_mesh_vendor_status *rsp);
+
+	/** @brief Bulk transfer start callback
+	 *
+	 * Called when a Vendor_Bulk_Start message is received. Optional, bulk
+	 * transfers are rejected if not set.
+	 *
+	 * @param srv    Vendor Server model
+	 * @param ctx    Message context
+	 * @param len    Total length of the transfer
+	 *
+	 * @return Buffer of at least @p len bytes to reassemble the transfer
+	 *         into, or NULL to reject the transfer
+	 */
+	uint8_t *(*const bulk_start)(struct bt_mesh_vendor_srv *srv,
+				     struct bt_mesh_msg_ctx *ctx, size_t len);
+
+	/** @brief Bulk transfer end callback
+	 *
+	 * Called when all chunks of a bulk transfer have been received.
+	 *
+	 * @param srv    Vendor Server model
+	 * @param ctx    Message context of the last chunk
+	 * @param data   Buffer returned by the start callback
+	 * @param len    Total length of the transfer
+	 * @param err    0 if the checksum matches, or -EBADMSG otherwise
+	 */
+	void (*const bulk_end)(struct bt_mesh_vendor_srv *srv,
+			       struct bt_mesh_msg_ctx *ctx,
+			       uint8_t *data, size_t len, int err);
+
+	/** @brief Restore callback
+	 *
+	 * Called when the mesh stack starts, with the last SET payload the
+	 * server received before the node restarted. Optional, and only
+	 * called with @kconfig{CONFIG_BT_MESH_VENDOR_SRV_STORE} if a
+	 * non-empty payload was stored.
+	 *
+	 * @param srv    Vendor Server model
+	 * @param set    Stored SET payload
+	 */
+	void (*const restore)(struct bt_mesh_vendor_srv *srv,
+			      const struct bt_mesh_vendor_set *set);
+
+	/** @brief Page read callback
+	 *
+	 * Called when a Vendor_Get_Page message is received, to read one page
+	 * of a dataset larger than a single Vendor_Status. The page is added
+	 * straight to the response, nothing is copied through the status
+	 * buffer. Optional, and only used with
+	 * @kconfig{CONFIG_BT_MESH_VENDOR_PAGE}.
+	 *
+	 * @param srv    Vendor Server model
+	 * @param ctx    Message context
+	 * @param offset Offset of the page in the dataset
+	 * @param buf    Buffer to add the page data to. Its tailroom is the
+	 *               page length the client asked for, and it should be
+	 *               filled unless the dataset ends first.
+	 *
+	 * @return Total length of the dataset, or negative error code if the
+	 *         page can't be read
+	 */
+	int (*const page_read)(struct bt_mesh_vendor_srv *srv,
+			       struct bt_mesh_msg_ctx *ctx, uint32_t offset,
+			       struct net_buf_simple *buf);
+
+	/** @brief Key change callback
+	 *
+	 * Called after a Vendor_KV_Set or Vendor_KV_Set_Unack has changed the
+	 * value of a key. Optional, and only used with
+	 * @kconfig{CONFIG_BT_MESH_VENDOR_KV}.
+	 *
+	 * @param srv    Vendor Server model
+	 * @param ctx    Message context
+	 * @param kv     Key table entry of the key, with the new value
+	 */
+	void (*const kv_changed)(struct bt_mesh_vendor_srv *srv,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const struct bt_mesh_vendor_kv *kv);
+
+	/** Key table, sorted by key, see @ref BT_MESH_VENDOR_KV. Optional, and
+	 *  only used with @kconfig{CONFIG_BT_MESH_VENDOR_KV}.
+	 */
+	const struct bt_mesh_vendor_kv *const kvs;
+	/** Number of entries in @c kvs, at most @kconfig{CONFIG_BT_MESH_VENDOR_KV_COUNT} */
+	const size_t kv_count;
+
+	/** Command table, indexed by command ID, see @ref BT_MESH_VENDOR_CMD.
+	 *  Optional, and only used with @kconfig{CONFIG_BT_MESH_VENDOR_CMD}.
+	 */
+	const struct bt_mesh_vendor_cmd *const cmds;
+	/** Number of entries in @c cmds */
+	const size_t cmd_count;
 };
 
 /** Vendor Server Model Context */
@@ -80,16 +350,122 @@ struct bt_mesh_vendor_srv {
 	/** Publication message */
 	struct net_buf_simple pub_msg;
 	/** Publication message buffer */
-	uint8_t buf[BT_MESH_VENDOR_MSG_MAXLEN_STATUS + 4];
-	/** Status buffer */
+	uint8_t buf[BT_MESH_MODEL_BUF_LEN(BT_MESH_VENDOR_OP_STATUS,
+					  BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_STATUS)];
+	/** Status buffer, a view of the data part of @c status_buf_data */
 	struct net_buf_simple status_msg;
-	/** Current status data */
-	uint8_t status_buf_data[BT_MESH_VENDOR_MSG_MAXLEN_STATUS + 4];
+	/** Outgoing STATUS message. Handlers write the response data directly
+	 *  after the header, and the message is sent from here without copying.
+	 *  The content is consumed when sent.
+	 */
+	uint8_t status_buf_data[BT_MESH_MODEL_BUF_LEN(BT_MESH_VENDOR_OP_STATUS,
+						      BT_MESH_VENDOR_TID_LEN +
+						      BT_MESH_VENDOR_MSG_MAXLEN_STATUS)];
+	/** Capabilities of recently seen clients */
+	struct bt_mesh_vendor_peer peers[CONFIG_BT_MESH_VENDOR_PEER_COUNT];
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_STORE)
+	/** Last SET payload received, the stored state */
+	struct {
+		/** Payload */
+		uint8_t data[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+		/** Length of the payload */
+		uint16_t len;
+		/** Version of the payload, see @ref bt_mesh_vendor_version */
+		uint32_t version;
+		/** Whether a SET has been received */
+		bool valid;
+		/** Version of the payload in persistent storage */
+		uint32_t stored_version;
+		/** Whether a payload is in persistent storage */
+		bool stored;
+	} image;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	/** Delta SET state */
+	struct {
+		/** Base of the delta SETs of each client */
+		struct bt_mesh_vendor_srv_base bases[CONFIG_BT_MESH_VENDOR_DELTA_SRV_PEER_COUNT];
+		/** Use counter, to find the least recently used base */
+		uint32_t seq;
+	} delta;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_PUB_ON_CHANGE)
+	/** Change-driven publication state */
+	struct {
+		/** Publishes the status once the minimum interval has passed */
+		struct k_work_delayable work;
+		/** Uptime of the last publication */
+		int64_t last;
+		/** Version of the last status published, see @ref bt_mesh_vendor_version */
+		uint32_t version;
+		/** Whether a status has been published */
+		bool valid;
+	} pub_change;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	/** Stream reception state */
+	struct {
+		/** Streams of recently active clients, protected by @c lock */
+		struct bt_mesh_vendor_srv_stream streams[CONFIG_BT_MESH_VENDOR_STREAM_SRC_COUNT];
+		/** Sends nacks for missing records */
+		struct k_work_delayable nack_work;
+		/** Protects the stream table */
+		struct k_spinlock lock;
+	} stream;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+	/** Duplicate request cache */
+	struct {
+		/** Recent requests, one per source address and TID, protected by @c lock */
+		struct bt_mesh_vendor_srv_dup entries[CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE_SIZE];
+		/** Protects the cache */
+		struct k_spinlock lock;
+	} dup;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	/** Key change notification state */
+	struct {
+		/** Keys changed since they were last published, bit n is entry n of the key
+		 *  table. Protected by @c lock.
+		 */
+		uint32_t changed[DIV_ROUND_UP(CONFIG_BT_MESH_VENDOR_KV_COUNT, 32)];
+		/** Publishes the changed keys */
+		struct k_work_delayable work;
+		/** Protects the changed keys */
+		struct k_spinlock lock;
+	} kv;
+#endif
+	/** Bulk transfer reception state */
+	struct {
+		/** Reassembly buffer */
+		uint8_t *data;
+		/** Total length of the transfer */
+		uint32_t len;
+		/** Expected CRC-32 of the transfer */
+		uint32_t crc;
+		/** Chunks received after the base chunk */
+		uint32_t bitmap;
+		/** Source address of the transfer */
+		uint16_t src;
+		/** Number of chunks in the transfer */
+		uint16_t count;
+		/** First chunk not yet received */
+		uint16_t base;
+		/** Transfer ID */
+		uint8_t id;
+		/** Chunk size */
+		uint8_t chunk_size;
+		/** Current status, see @ref bt_mesh_vendor_bulk_status */
+		uint8_t status;
+		/** Whether the state belongs to a started transfer */
+		bool valid;
+	} bulk;
 };
 
 /** @cond INTERNAL_HIDDEN */
 extern const struct bt_mesh_model_op _bt_mesh_vendor_srv_op[];
 extern const struct bt_mesh_model_cb _bt_mesh_vendor_srv_cb;
+int _bt_mesh_vendor_srv_update_handler(const struct bt_mesh_model *model);
 /** @endcond */
 
 /** Vendor Server model composition data entry. */
@@ -117,6 +493,12 @@ static inline void bt_mesh_vendor_srv_set_handlers(struct bt_mesh_vendor_srv *sr
 /**
  * @brief Send a status message
  *
+ * If @c rsp->buf is the server's own status buffer, the message is sent in
+ * place without copying the data, and the buffer content is consumed.
+ *
+ * Without @p ctx, @p rsp is published to the configured publication address,
+ * with @ref BT_MESH_VENDOR_TID_NONE as the transaction ID.
+ *
  * @param srv Vendor Server model
  * @param ctx Message context to send with, or NULL to publish
  * @param rsp Vendor status message to be sent
@@ -126,6 +508,41 @@ int bt_mesh_vendor_srv_status_send(struct bt_mesh_vendor_srv *srv,
                                    struct bt_mesh_msg_ctx *ctx,
                                    struct bt_mesh_vendor_status *rsp);
 
+/**
+ * @brief Publish the server status because it has changed
+ *
+ * The status is filled in by the @c get handler and published to the
+ * configured publication address, once @kconfig{CONFIG_BT_MESH_VENDOR_SRV_PUB_INTERVAL}
+ * has passed since the last publication. Calls made before then are
+ * published together, and nothing is published if the status is the same
+ * as the last one published. The server calls this itself after every SET.
+ *
+ * Requires @kconfig{CONFIG_BT_MESH_VENDOR_SRV_PUB_ON_CHANGE}.
+ *
+ * @param srv Vendor Server model
+ * @return 0 on success, -EADDRNOTAVAIL if publication isn't configured, or
+ *         -ENOTSUP if the feature is disabled
+ */
+int bt_mesh_vendor_srv_pub_changed(struct bt_mesh_vendor_srv *srv);
+
+/**
+ * @brief Publish a key because its value has changed
+ *
+ * The key is published in a Vendor_KV_Status to the configured publication
+ * address, along with every other key changed within
+ * @kconfig{CONFIG_BT_MESH_VENDOR_KV_PUB_DELAY}. Only the changed keys are
+ * sent. The server calls this itself for every key a client changes.
+ *
+ * Requires @kconfig{CONFIG_BT_MESH_VENDOR_KV}.
+ *
+ * @param srv Vendor Server model
+ * @param key Key whose value has changed
+ * @return 0 on success, -ENOENT if the key isn't in the key table,
+ *         -EADDRNOTAVAIL if publication isn't configured, or -ENOTSUP if
+ *         the feature is disabled
+ */
+int bt_mesh_vendor_srv_kv_changed(struct bt_mesh_vendor_srv *srv, uint8_t key);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef VND_STATS_H__
+#define VND_STATS_H__
+
+#include <zephyr/bluetooth/mesh.h>
+#include "vnd_common.h"
+
+/**
+ * @brief Vendor model statistics
+ * @defgroup bt_mesh_vendor_stats Vendor model statistics
+ * @{
+ *
+ * The functions are only available with @kconfig{CONFIG_BT_MESH_VENDOR_STATS}.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** First byte of the first vendor opcode with counters */
+#define BT_MESH_VENDOR_STATS_OP_FIRST  (0x10)
+
+/** Number of vendor opcodes with counters, covering every opcode from
+ *  @ref BT_MESH_VENDOR_STATS_OP_FIRST to the end of the vendor opcode space
+ */
+#define BT_MESH_VENDOR_STATS_OP_COUNT  (0x40 - BT_MESH_VENDOR_STATS_OP_FIRST)
+
+/** Number of histogram buckets. Bucket n counts values from 2^n up to
+ *  2^(n+1) - 1, except that bucket 0 also counts 0, and the last bucket
+ *  counts everything above.
+ */
+#define BT_MESH_VENDOR_STATS_BUCKETS   (16)
+
+/** Number of vendor command IDs with counters, starting from 0 */
+#if defined(CONFIG_BT_MESH_VENDOR_STATS_CMD_COUNT)
+#define BT_MESH_VENDOR_STATS_CMD_COUNT CONFIG_BT_MESH_VENDOR_STATS_CMD_COUNT
+#else
+#define BT_MESH_VENDOR_STATS_CMD_COUNT 0
+#endif
+
+/** Histograms kept by the vendor models */
+enum bt_mesh_vendor_stats_hist {
+	/** Time from sending an acknowledged request to its response, in milliseconds */
+	BT_MESH_VENDOR_STATS_HIST_RTT,
+	/** Time spent in the server's @c set and @c get handlers, in microseconds */
+	BT_MESH_VENDOR_STATS_HIST_HANDLER,
+
+	BT_MESH_VENDOR_STATS_HIST_COUNT,
+};
+
+/** Contents of a Vendor_Stats_Status message */
+enum bt_mesh_vendor_stats_kind {
+	/** A histogram, selected by a @ref bt_mesh_vendor_stats_hist */
+	BT_MESH_VENDOR_STATS_KIND_HIST,
+	/** Counters of an opcode, selected by the first byte of the opcode */
+	BT_MESH_VENDOR_STATS_KIND_OP,
+	/** Counters of a vendor command, selected by the command ID */
+	BT_MESH_VENDOR_STATS_KIND_CMD,
+};
+
+/** Counters of a single opcode */
+struct bt_mesh_vendor_stats_op {
+	/** Messages handed to the mesh stack */
+	uint32_t tx;
+	/** Messages received */
+	uint32_t rx;
+	/** Parameter bytes sent, excluding the opcode */
+	uint32_t tx_bytes;
+	/** Parameter bytes received, excluding the opcode */
+	uint32_t rx_bytes;
+	/** Requests that timed out without a response */
+	uint32_t timeouts;
+	/** Messages rejected with -EMSGSIZE, sent or received */
+	uint32_t rejected;
+	/** Requests the server application deferred the response to */
+	uint32_t deferred;
+};
+
+/** Number of counters in a @ref bt_mesh_vendor_stats_op */
+#define BT_MESH_VENDOR_STATS_OP_FIELDS (sizeof(struct bt_mesh_vendor_stats_op) / sizeof(uint32_t))
+
+/** Counters of a single vendor command, kept by the server */
+struct bt_mesh_vendor_stats_cmd {
+	/** Commands passed to the command handler */
+	uint32_t calls;
+	/** Commands rejected for their parameter length */
+	uint32_t rejected;
+	/** Commands the handler returned an error for */
+	uint32_t failed;
+	/** Total time spent in the command handler, in microseconds */
+	uint32_t time_us;
+};
+
+/** Number of counters in a @ref bt_mesh_vendor_stats_cmd */
+#define BT_MESH_VENDOR_STATS_CMD_FIELDS (sizeof(struct bt_mesh_vendor_stats_cmd) / sizeof(uint32_t))
+
+/** Statistics of all vendor model instances on the node */
+struct bt_mesh_vendor_stats {
+	/** Counters of each opcode, see @ref bt_mesh_vendor_stats_op_idx */
+	struct bt_mesh_vendor_stats_op op[BT_MESH_VENDOR_STATS_OP_COUNT];
+#if BT_MESH_VENDOR_STATS_CMD_COUNT
+	/** Counters of each vendor command, indexed by command ID */
+	struct bt_mesh_vendor_stats_cmd cmd[BT_MESH_VENDOR_STATS_CMD_COUNT];
+#endif
+	/** Histograms, indexed by @ref bt_mesh_vendor_stats_hist */
+	uint32_t hist[BT_MESH_VENDOR_STATS_HIST_COUNT][BT_MESH_VENDOR_STATS_BUCKETS];
+};
+
+/**
+ * @brief Index of an opcode in @ref bt_mesh_vendor_stats::op
+ *
+ * @param op Vendor opcode
+ * @return Index of the opcode, or -ENOENT if it isn't a vendor opcode with counters
+ */
+static inline int bt_mesh_vendor_stats_op_idx(uint32_t op)
+{
+	uint8_t b0 = (op >> 16) & 0x3f;
+
+	if (BT_MESH_MODEL_OP_LEN(op) != 3 || (op & 0xffff) != BT_COMP_ID_VENDOR ||
+	    b0 < BT_MESH_VENDOR_STATS_OP_FIRST) {
+		return -ENOENT;
+	}
+
+	return b0 - BT_MESH_VENDOR_STATS_OP_FIRST;
+}
+
+/**
+ * @brief Get a copy of the statistics
+ *
+ * @param stats Statistics to fill
+ */
+void bt_mesh_vendor_stats_get(struct bt_mesh_vendor_stats *stats);
+
+/** @brief Reset all counters and histograms to zero */
+void bt_mesh_vendor_stats_reset(void);
+
+/**
+ * @brief Add the contents of a Vendor_Stats_Status to a message
+ *
+ * @param buf  Message to add the counters or histogram to, in little endian
+ * @param kind What to add, see @ref bt_mesh_vendor_stats_kind
+ * @param arg  Histogram, first opcode byte or command ID to add
+ * @return 0 on success, -ENOENT if there is no such histogram, opcode or command, or
+ *         -ENOBUFS if @p buf is too small
+ */
+int bt_mesh_vendor_stats_encode(struct net_buf_simple *buf, uint8_t kind, uint8_t arg);
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+void _bt_mesh_vendor_stats_tx(const struct net_buf_simple *msg);
+void _bt_mesh_vendor_stats_rx(uint32_t op, size_t len);
+void _bt_mesh_vendor_stats_timeout(uint32_t op);
+void _bt_mesh_vendor_stats_rejected(uint32_t op);
+void _bt_mesh_vendor_stats_deferred(uint32_t op);
+void _bt_mesh_vendor_stats_hist_add(enum bt_mesh_vendor_stats_hist hist, uint32_t value);
+void _bt_mesh_vendor_stats_cmd(uint8_t cmd, enum bt_mesh_vendor_cmd_result result,
+			       uint32_t time_us);
+#else
+static inline void _bt_mesh_vendor_stats_tx(const struct net_buf_simple *msg) {}
+static inline void _bt_mesh_vendor_stats_rx(uint32_t op, size_t len) {}
+static inline void _bt_mesh_vendor_stats_timeout(uint32_t op) {}
+static inline void _bt_mesh_vendor_stats_rejected(uint32_t op) {}
+static inline void _bt_mesh_vendor_stats_deferred(uint32_t op) {}
+static inline void _bt_mesh_vendor_stats_hist_add(enum bt_mesh_vendor_stats_hist hist,
+						  uint32_t value) {}
+static inline void _bt_mesh_vendor_stats_cmd(uint8_t cmd, enum bt_mesh_vendor_cmd_result result,
+					     uint32_t time_us) {}
+#endif
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* VND_STATS_H__ */
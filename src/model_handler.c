@@ -14,6 +14,7 @@
 
 #include "../include/vnd_srv.h"
 #include "../include/vnd_cli.h"
+#include "../include/vnd_pool.h"
 #include "model_handler.h"
 
 LOG_MODULE_REGISTER(model_handler, CONFIG_BT_MESH_MODEL_LOG_LEVEL);
@@ -40,9 +41,61 @@ static int handle_vendor_get(struct bt_mesh_vendor_srv *srv,
 				const struct bt_mesh_vendor_get *get,
 				struct bt_mesh_vendor_status *rsp);
 
+static uint8_t *handle_vendor_bulk_start(struct bt_mesh_vendor_srv *srv,
+					 struct bt_mesh_msg_ctx *ctx, size_t len);
+
+static void handle_vendor_bulk_end(struct bt_mesh_vendor_srv *srv,
+				   struct bt_mesh_msg_ctx *ctx,
+				   uint8_t *data, size_t len, int err);
+
+static void handle_vendor_restore(struct bt_mesh_vendor_srv *srv,
+				  const struct bt_mesh_vendor_set *set);
+
+static int handle_vendor_page_read(struct bt_mesh_vendor_srv *srv,
+				   struct bt_mesh_msg_ctx *ctx, uint32_t offset,
+				   struct net_buf_simple *buf);
+
+static int handle_cmd_echo(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			   struct net_buf_simple *params, struct net_buf_simple *rsp);
+
+static int handle_cmd_uptime(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			     struct net_buf_simple *params, struct net_buf_simple *rsp);
+
+/* Command table, indexed by command ID */
+static const struct bt_mesh_vendor_cmd vendor_cmds[] = {
+	[MODEL_HANDLER_CMD_ECHO] = BT_MESH_VENDOR_CMD(handle_cmd_echo, 0,
+						      BT_MESH_VENDOR_CMD_RSP_MAXLEN),
+	[MODEL_HANDLER_CMD_UPTIME] = BT_MESH_VENDOR_CMD_EXACT(handle_cmd_uptime, 0),
+};
+
+static void handle_vendor_kv_changed(struct bt_mesh_vendor_srv *srv,
+				     struct bt_mesh_msg_ctx *ctx,
+				     const struct bt_mesh_vendor_kv *kv);
+
+/* Sample keys */
+static uint8_t kv_brightness = 100;
+static uint16_t kv_interval = 1000;
+static uint32_t kv_version = 0x00010000;
+
+/* Key table, sorted by key */
+static const struct bt_mesh_vendor_kv vendor_kvs[] = {
+	BT_MESH_VENDOR_KV(0x01, kv_brightness),
+	BT_MESH_VENDOR_KV(0x02, kv_interval),
+	BT_MESH_VENDOR_KV_RO(0x10, kv_version),
+};
+
 static const struct bt_mesh_vendor_srv_handlers vendor_srv_handlers = {
 	.set = handle_vendor_set,
 	.get = handle_vendor_get,
+	.bulk_start = handle_vendor_bulk_start,
+	.bulk_end = handle_vendor_bulk_end,
+	.restore = handle_vendor_restore,
+	.page_read = handle_vendor_page_read,
+	.kv_changed = handle_vendor_kv_changed,
+	.kvs = vendor_kvs,
+	.kv_count = ARRAY_SIZE(vendor_kvs),
+	.cmds = vendor_cmds,
+	.cmd_count = ARRAY_SIZE(vendor_cmds),
 };
 
 /* Set up a repeating delayed work to blink the DK's LEDs when attention is requested. */
@@ -87,6 +140,27 @@ static struct bt_mesh_health_srv health_srv = {
 
 BT_MESH_HEALTH_PUB_DEFINE(health_pub, 0);
 
+/* Log a payload as a string. The copy needed for the terminator is made in a pool buffer,
+ * as this runs on the Bluetooth receive thread.
+ */
+static void log_payload(const char *prefix, const struct net_buf_simple *buf)
+{
+	struct net_buf_simple str;
+	size_t len = MIN(buf->len, BT_MESH_VENDOR_POOL_BUF_SIZE - 1);
+
+	if (bt_mesh_vendor_pool_buf_get(&str)) {
+		LOG_INF("%s: %u bytes", prefix, buf->len);
+		return;
+	}
+
+	net_buf_simple_add_mem(&str, buf->data, len);
+	net_buf_simple_add_u8(&str, '\0');
+
+	LOG_INF("%s: \"%s\"", prefix, (char *)str.data);
+
+	bt_mesh_vendor_pool_buf_put(&str);
+}
+
 /**************************************************************************************************/
 /* Server model instance */
 static struct bt_mesh_vendor_srv vendor_srv = BT_MESH_VENDOR_SRV_INIT(&vendor_srv_handlers);
@@ -97,21 +171,7 @@ static int handle_vendor_set(struct bt_mesh_vendor_srv *srv,
 				const struct bt_mesh_vendor_set *set,
 				struct bt_mesh_vendor_status *rsp)
 {
-	char data[BT_MESH_VENDOR_MSG_MAXLEN_SET + 1] = {0};
-	size_t len = set->buf->len;
-
-	/* Safety check for buffer size */
-	if (len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
-		len = BT_MESH_VENDOR_MSG_MAXLEN_SET;
-	}
-
-	/* Copy data for display */
-	if (len > 0) {
-		memcpy(data, set->buf->data, len);
-		data[len] = '\0'; /* Null-terminate the string */
-	}
-
-	LOG_INF("Received SET message: \"%s\"", data);
+	log_payload("Received SET message", set->buf);
 
 	/* Populate the response status message */
 	net_buf_simple_reset(rsp->buf);
@@ -146,6 +206,86 @@ static int handle_vendor_get(struct bt_mesh_vendor_srv *srv,
 	return 0; /* Return success to send response immediately */
 }
 
+/* Bulk transfer reassembly buffer */
+static uint8_t bulk_buf[2048];
+
+/* Length of the last bulk transfer received, served back as a paged dataset */
+static size_t bulk_len;
+
+/* Server bulk transfer start callback */
+static uint8_t *handle_vendor_bulk_start(struct bt_mesh_vendor_srv *srv,
+					 struct bt_mesh_msg_ctx *ctx, size_t len)
+{
+	if (len > sizeof(bulk_buf)) {
+		LOG_WRN("Rejecting bulk transfer of %zu bytes from 0x%04x", len, ctx->addr);
+		return NULL;
+	}
+
+	LOG_INF("Receiving bulk transfer of %zu bytes from 0x%04x", len, ctx->addr);
+
+	return bulk_buf;
+}
+
+/* Server bulk transfer end callback */
+static void handle_vendor_bulk_end(struct bt_mesh_vendor_srv *srv,
+				   struct bt_mesh_msg_ctx *ctx,
+				   uint8_t *data, size_t len, int err)
+{
+	if (err) {
+		LOG_ERR("Bulk transfer of %zu bytes failed (err: %d)", len, err);
+		return;
+	}
+
+	LOG_INF("Received bulk transfer of %zu bytes", len);
+	bulk_len = len;
+}
+
+/* Server page read callback, reads back the last bulk transfer received */
+static int handle_vendor_page_read(struct bt_mesh_vendor_srv *srv,
+				   struct bt_mesh_msg_ctx *ctx, uint32_t offset,
+				   struct net_buf_simple *buf)
+{
+	if (offset < bulk_len) {
+		net_buf_simple_add_mem(buf, &bulk_buf[offset],
+				       MIN(bulk_len - offset, net_buf_simple_tailroom(buf)));
+	}
+
+	LOG_DBG("Page read at offset %u, %u bytes", offset, buf->len);
+
+	return bulk_len;
+}
+
+/* Server key-value callback, when a client writes a new value */
+static void handle_vendor_kv_changed(struct bt_mesh_vendor_srv *srv,
+				     struct bt_mesh_msg_ctx *ctx,
+				     const struct bt_mesh_vendor_kv *kv)
+{
+	LOG_INF("Key 0x%02x written by 0x%04x", kv->key, ctx->addr);
+}
+
+/* Server restore callback, with the last SET payload received before the restart */
+static void handle_vendor_restore(struct bt_mesh_vendor_srv *srv,
+				  const struct bt_mesh_vendor_set *set)
+{
+	log_payload("Restored SET message", set->buf);
+}
+
+static int handle_cmd_echo(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			   struct net_buf_simple *params, struct net_buf_simple *rsp)
+{
+	net_buf_simple_add_mem(rsp, params->data, params->len);
+
+	return 0;
+}
+
+static int handle_cmd_uptime(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			     struct net_buf_simple *params, struct net_buf_simple *rsp)
+{
+	net_buf_simple_add_le32(rsp, k_uptime_get_32());
+
+	return 0;
+}
+
 /**************************************************************************************************/
 /* Client model instance */
 static struct bt_mesh_vendor_cli vendor_cli = BT_MESH_VND_CLI_INIT(handle_vendor_status);
@@ -155,45 +295,103 @@ static void handle_vendor_status(struct bt_mesh_vendor_cli *cli,
 				  struct bt_mesh_msg_ctx *ctx,
 				  const struct bt_mesh_vendor_status *status)
 {
-	char data[BT_MESH_VENDOR_MSG_MAXLEN_STATUS + 1] = {0};
-	size_t len = status->buf->len;
+	log_payload("Received STATUS response", status->buf);
+}
 
-	if (len > BT_MESH_VENDOR_MSG_MAXLEN_STATUS) {
-		len = BT_MESH_VENDOR_MSG_MAXLEN_STATUS;
-	}
 
-	if (len > 0) {
-		memcpy(data, status->buf->data, len);
-		data[len] = '\0'; /* Null-terminate the string */
+struct bt_mesh_vendor_cli *model_handler_vendor_cli(void)
+{
+	return &vendor_cli;
+}
+
+int vendor_model_send_set(const uint8_t *data, size_t len, struct bt_mesh_vendor_status *rsp)
+{
+	LOG_INF("Sending SET message: \"%s\"", (char *)data);
+
+	/* The data is written straight into the outgoing message */
+	struct bt_mesh_vendor_iov iov = {
+		.data = data,
+		.len = len,
+	};
+	struct bt_mesh_vendor_set set = {
+		.iov = &iov,
+		.iov_cnt = 1,
+	};
+
+	return bt_mesh_vendor_cli_set(&vendor_cli, NULL, &set, rsp);
+}
+
+/* Completion callback for the requests sent from the buttons. Logs the memory report after
+ * every request, as the pool and stacks have just been used.
+ */
+static void handle_vendor_request_done(struct bt_mesh_vendor_cli *cli,
+				       struct bt_mesh_msg_ctx *ctx,
+				       const struct bt_mesh_vendor_status *status,
+				       int err, void *user_data)
+{
+	const char *name = user_data;
+
+	if (err) {
+		LOG_ERR("%s request failed (err: %d)", name, err);
+	} else {
+		LOG_INF("%s request TID %u answered by 0x%04x", name, status->tid, ctx->addr);
 	}
 
-	LOG_INF("Received STATUS response: \"%s\"", data);
+	bt_mesh_vendor_mem_report();
 }
 
+/* Version of the status data last received from button 3 */
+static uint32_t get_version;
 
-int vendor_model_send_set(const uint8_t *data, size_t len, struct bt_mesh_vendor_status *rsp)
+/* Completion callback for the conditional GET sent from button 3 */
+static void handle_vendor_get_cond_done(struct bt_mesh_vendor_cli *cli,
+					struct bt_mesh_msg_ctx *ctx,
+					const struct bt_mesh_vendor_status *status,
+					int err, void *user_data)
 {
-	LOG_INF("Sending SET message: \"%s\"", (char *)data);
+	if (err == -EALREADY) {
+		LOG_INF("GET answered by 0x%04x, status unchanged", ctx->addr);
+		bt_mesh_vendor_mem_report();
+		return;
+	}
+
+	if (!err) {
+		get_version = bt_mesh_vendor_version(status->buf);
+	}
 
-	NET_BUF_SIMPLE_DEFINE(temp_buf, BT_MESH_VENDOR_MSG_MAXLEN_SET);
-	net_buf_simple_add_mem(&temp_buf, data, len);
+	handle_vendor_request_done(cli, ctx, status, err, user_data);
+}
 
+int vendor_model_send_set_async(const uint8_t *data, size_t len,
+				bt_mesh_vendor_cli_cb_t cb, void *user_data)
+{
+	LOG_INF("Sending SET message: \"%s\"", (char *)data);
+
+	/* The data is written straight into the outgoing message */
+	struct bt_mesh_vendor_iov iov = {
+		.data = data,
+		.len = len,
+	};
 	struct bt_mesh_vendor_set set = {
-		.buf = &temp_buf
+		.iov = &iov,
+		.iov_cnt = 1,
 	};
 
-	return bt_mesh_vendor_cli_set(&vendor_cli, NULL, &set, rsp);
+	return bt_mesh_vendor_cli_set_async(&vendor_cli, NULL, &set, cb, user_data, NULL);
 }
 
 int vendor_model_send_set_unack(const uint8_t *data, size_t len)
 {
 	LOG_INF("Sending SET UNACK message: \"%s\"", (char *)data);
 
-	NET_BUF_SIMPLE_DEFINE(temp_buf, BT_MESH_VENDOR_MSG_MAXLEN_SET);
-	net_buf_simple_add_mem(&temp_buf, data, len);
-
+	/* The data is written straight into the outgoing message */
+	struct bt_mesh_vendor_iov iov = {
+		.data = data,
+		.len = len,
+	};
 	struct bt_mesh_vendor_set set = {
-		.buf = &temp_buf
+		.iov = &iov,
+		.iov_cnt = 1,
 	};
 
 	return bt_mesh_vendor_cli_set_unack(&vendor_cli, NULL, &set);
@@ -205,8 +403,9 @@ static void button_handler(uint32_t pressed, uint32_t changed)
 	int err;
 
 	if (pressed & changed & BIT(DK_BTN1)) {
-		/* Send SET message with "Hello World" string */
-		err = vendor_model_send_set((const uint8_t *)set_msg, strlen(set_msg), NULL);
+		/* Send SET message with "Hello World" string, without blocking the workqueue */
+		err = vendor_model_send_set_async((const uint8_t *)set_msg, strlen(set_msg),
+						  handle_vendor_request_done, "SET");
 		if (err) {
 			LOG_ERR("Failed to send SET message (err: %d)", err);
 		}
@@ -220,8 +419,9 @@ static void button_handler(uint32_t pressed, uint32_t changed)
 		}
 	}
 	if (pressed & changed & BIT(DK_BTN3)) {
-		/* Send GET message to request status */
-		err = bt_mesh_vendor_cli_get(&vendor_cli, NULL, NULL, NULL);
+		/* Send GET message to request status, unless it's the same as last time */
+		err = bt_mesh_vendor_cli_get_cond_async(&vendor_cli, NULL, NULL, get_version,
+							handle_vendor_get_cond_done, "GET", NULL);
 		if (err) {
 			LOG_ERR("Failed to send GET message (err: %d)", err);
 		}
@@ -233,7 +433,8 @@ static void button_handler(uint32_t pressed, uint32_t changed)
 		};
 
 		LOG_INF("Sending GET message with length parameter set to 1");
-		err = bt_mesh_vendor_cli_get(&vendor_cli, NULL, &get, NULL);
+		err = bt_mesh_vendor_cli_get_async(&vendor_cli, NULL, &get,
+						   handle_vendor_request_done, "GET", NULL);
 		if (err) {
 			LOG_ERR("Failed to send GET message with length=1 (err: %d)", err);
 		}
@@ -10,6 +10,14 @@
 #include <zephyr/bluetooth/mesh.h>
 #include "vnd_cli.h"
 
+/** Vendor commands handled by the server of this sample */
+enum model_handler_cmd {
+	/** Answer with the parameters */
+	MODEL_HANDLER_CMD_ECHO,
+	/** Answer with the uptime in milliseconds, 4 bytes little endian */
+	MODEL_HANDLER_CMD_UPTIME,
+};
+
 /**
  * @brief Initialize the model handler module
  *
@@ -27,6 +35,18 @@ const struct bt_mesh_comp *model_handler_init(void);
  */
 int vendor_model_send_set(const uint8_t *data, size_t len, struct bt_mesh_vendor_status *rsp);
 
+/**
+ * @brief Send a Vendor Set message without waiting for the response
+ *
+ * @param data      Data to send
+ * @param len       Length of data
+ * @param cb        Called with the response, or when the request times out
+ * @param user_data User data passed to @p cb
+ * @return 0 on success, negative error code otherwise
+ */
+int vendor_model_send_set_async(const uint8_t *data, size_t len,
+				bt_mesh_vendor_cli_cb_t cb, void *user_data);
+
 /**
  * @brief Send a Vendor Get message
  *
@@ -43,4 +63,11 @@ int vendor_model_send_get(void);
  */
 int vendor_model_send_set_unack(const uint8_t *data, size_t len);
 
+/**
+ * @brief Get the Vendor Client model instance of the node
+ *
+ * @return The Vendor Client model
+ */
+struct bt_mesh_vendor_cli *model_handler_vendor_cli(void);
+
 #endif /* MODEL_HANDLER_H__ */
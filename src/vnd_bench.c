@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file
+ *  @brief Vendor model throughput and latency benchmark
+ *
+ * Sweeps payload size, acknowledged and unacknowledged SETs, and TTL for
+ * every destination given on the command line, and prints one CSV row per
+ * step. Runs on hardware, or on nrf52_bsim with one instance per simulated
+ * node. The steps themselves don't depend on the shell, so the multi-node
+ * test in tests/vnd_bench runs the same sweep.
+ *
+ * The loopback command sends every request to the node's own server instead,
+ * through the mesh stack's local delivery. Nothing goes over the air, so the
+ * cost of encoding, dispatching and decoding each message can be measured
+ * without radio timing, and the responses are checked along the way.
+ */
+
+#include <string.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include "../include/vnd_cli.h"
+#include "../include/vnd_stats.h"
+#include "vnd_bench.h"
+
+#if defined(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#include "model_handler.h"
+#endif
+
+LOG_MODULE_REGISTER(vnd_bench, CONFIG_BT_MESH_MODEL_LOG_LEVEL);
+
+#define BENCH_COUNT CONFIG_BT_MESH_VENDOR_BENCH_COUNT
+
+/* Maximum number of destinations in one run */
+#define BENCH_DST_MAX 4
+
+/* Time for the last unacknowledged messages to arrive before asking for the receive count */
+#define BENCH_DRAIN_TIME K_MSEC(1000)
+
+const uint16_t vnd_bench_sizes[8] = {
+	0, 8, 11, 32, 64, 128, 256, BT_MESH_VENDOR_MSG_MAXLEN_SET,
+};
+
+/* State of the current step. The completion callbacks run on the Bluetooth receive thread
+ * and the system workqueue, the results are read by the shell thread once all credits are back.
+ */
+static struct {
+	struct k_spinlock lock;
+	struct k_sem credits;
+	uint32_t sent_at[BENCH_COUNT];
+	uint16_t rtt[BENCH_COUNT];
+	uint32_t acked;
+	uint32_t failed;
+} step;
+
+
+static void request_done(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			 const struct bt_mesh_vendor_status *status, int err, void *user_data)
+{
+	uint32_t seq = (uintptr_t)user_data;
+	k_spinlock_key_t key = k_spin_lock(&step.lock);
+
+	if (err) {
+		step.failed++;
+	} else {
+		step.rtt[step.acked++] = k_uptime_get_32() - step.sent_at[seq];
+	}
+
+	k_spin_unlock(&step.lock, key);
+	k_sem_give(&step.credits);
+}
+
+/* Retry while the transaction table, the buffers or the send pacer queue are full */
+static bool send_retry(int err)
+{
+	if (err == -EBUSY || err == -ENOMEM || err == -ENOBUFS || err == -EAGAIN) {
+		k_sleep(K_MSEC(10));
+		return true;
+	}
+
+	return false;
+}
+
+static void percentiles(struct vnd_bench_result *res)
+{
+	uint32_t n = step.acked;
+
+	if (!n) {
+		return;
+	}
+
+	/* Insertion sort, the sample is small */
+	for (uint32_t i = 1; i < n; i++) {
+		uint16_t v = step.rtt[i];
+		uint32_t j = i;
+
+		for (; j > 0 && step.rtt[j - 1] > v; j--) {
+			step.rtt[j] = step.rtt[j - 1];
+		}
+
+		step.rtt[j] = v;
+	}
+
+	res->p50 = step.rtt[(n - 1) / 2];
+	res->p99 = step.rtt[(n - 1) * 99 / 100];
+}
+
+void vnd_bench_ack(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		   const struct bt_mesh_vendor_set *set, struct vnd_bench_result *res)
+{
+	uint32_t start = k_uptime_get_32();
+
+	k_sem_init(&step.credits, CONFIG_BT_MESH_VENDOR_BENCH_WINDOW,
+		   CONFIG_BT_MESH_VENDOR_BENCH_WINDOW);
+	step.acked = 0;
+	step.failed = 0;
+
+	for (uint32_t seq = 0; seq < BENCH_COUNT; seq++) {
+		int err;
+
+		k_sem_take(&step.credits, K_FOREVER);
+
+		do {
+			step.sent_at[seq] = k_uptime_get_32();
+			err = bt_mesh_vendor_cli_set_async(cli, ctx, set, request_done,
+							   (void *)(uintptr_t)seq, NULL);
+		} while (send_retry(err));
+
+		if (err) {
+			LOG_WRN("SET %u failed (err: %d)", seq, err);
+			request_done(cli, NULL, NULL, err, (void *)(uintptr_t)seq);
+		}
+	}
+
+	/* Wait for every request to be answered or time out */
+	for (int i = 0; i < CONFIG_BT_MESH_VENDOR_BENCH_WINDOW; i++) {
+		k_sem_take(&step.credits, K_FOREVER);
+	}
+
+	res->elapsed = k_uptime_get_32() - start;
+	res->sent = BENCH_COUNT;
+	res->delivered = step.acked;
+	percentiles(res);
+}
+
+/* Number of SET_UNACK messages the server has received, in plain or compressed form */
+static int remote_unack_rx(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			   uint32_t *count)
+{
+	static const uint32_t ops[] = {
+		BT_MESH_VENDOR_OP_SET_UNACK,
+		BT_MESH_VENDOR_OP_SET_UNACK_Z,
+	};
+	struct bt_mesh_vendor_stats_op counters;
+	int err;
+
+	*count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(ops); i++) {
+		err = bt_mesh_vendor_cli_stats_op_get(cli, ctx, ops[i], &counters);
+		if (err) {
+			return err;
+		}
+
+		*count += counters.rx;
+	}
+
+	return 0;
+}
+
+void vnd_bench_unack(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		     const struct bt_mesh_vendor_set *set, struct vnd_bench_result *res)
+{
+	uint32_t start = k_uptime_get_32();
+	uint32_t rx_before;
+	uint32_t rx_after;
+	bool counted;
+
+	/* Only unicast servers with statistics can tell how many messages arrived */
+	counted = BT_MESH_ADDR_IS_UNICAST(ctx->addr) && !remote_unack_rx(cli, ctx, &rx_before);
+
+	res->sent = 0;
+
+	for (uint32_t seq = 0; seq < BENCH_COUNT; seq++) {
+		int err;
+
+		do {
+			err = bt_mesh_vendor_cli_set_unack(cli, ctx, set);
+		} while (send_retry(err));
+
+		if (err) {
+			LOG_WRN("SET UNACK %u failed (err: %d)", seq, err);
+		} else {
+			res->sent++;
+		}
+
+		k_sleep(K_MSEC(CONFIG_BT_MESH_VENDOR_BENCH_INTERVAL));
+	}
+
+	res->elapsed = k_uptime_get_32() - start;
+	res->delivered = -1;
+
+	if (counted) {
+		k_sleep(BENCH_DRAIN_TIME);
+
+		if (!remote_unack_rx(cli, ctx, &rx_after)) {
+			res->delivered = MIN(rx_after - rx_before, res->sent);
+		}
+	}
+}
+
+int vnd_bench_csv_row(char *buf, size_t len, const struct bt_mesh_msg_ctx *ctx, bool ack,
+		      uint16_t size, const struct vnd_bench_result *res)
+{
+	uint32_t elapsed = MAX(res->elapsed, 1);
+	uint32_t delivered = res->delivered < 0 ? res->sent : res->delivered;
+	char loss[8] = "";
+	char p50[8] = "";
+	char p99[8] = "";
+
+	if (res->delivered >= 0 && res->sent) {
+		snprintk(loss, sizeof(loss), "%u",
+			 (res->sent - res->delivered) * 100 / res->sent);
+	}
+
+	if (ack && res->delivered > 0) {
+		snprintk(p50, sizeof(p50), "%u", res->p50);
+		snprintk(p99, sizeof(p99), "%u", res->p99);
+	}
+
+	return snprintk(buf, len, "0x%04x,%u,%s,%u,%u,%u,%u,%u,%u,%s,%s,%s", ctx->addr,
+			ctx->send_ttl, ack ? "ack" : "unack", size, res->sent, delivered,
+			res->elapsed, res->sent * 1000 / elapsed,
+			delivered * size * 1000 / elapsed, p50, p99, loss);
+}
+
+#if defined(CONFIG_SHELL)
+static const uint8_t ttls[] = { 0, 3, 7 };
+
+static uint8_t payload[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+
+static void result_print(const struct shell *sh, const struct bt_mesh_msg_ctx *ctx, bool ack,
+			 uint16_t size, const struct vnd_bench_result *res)
+{
+	char row[80];
+
+	vnd_bench_csv_row(row, sizeof(row), ctx, ack, size, res);
+	shell_print(sh, "%s", row);
+}
+
+/* Access message bytes the vendor models on this node sent and received, including both
+ * sides of loopback
+ */
+static uint32_t msg_bytes(void)
+{
+	static struct bt_mesh_vendor_stats stats;
+	uint32_t bytes = 0;
+
+	bt_mesh_vendor_stats_get(&stats);
+
+	for (int i = 0; i < ARRAY_SIZE(stats.op); i++) {
+		bytes += stats.op[i].tx_bytes + stats.op[i].rx_bytes;
+	}
+
+	return bytes;
+}
+
+struct loopback_step {
+	uint32_t start;
+	uint32_t bytes;
+};
+
+static void loopback_start(struct loopback_step *ls)
+{
+	ls->bytes = msg_bytes();
+	ls->start = k_cycle_get_32();
+}
+
+static bool loopback_end(const struct shell *sh, const struct loopback_step *ls, const char *op,
+			 size_t size, bool ok)
+{
+	uint32_t cycles = k_cycle_get_32() - ls->start;
+
+	shell_print(sh, "%s,%zu,%u,%u,%u,%s", op, size, cycles, k_cyc_to_us_floor32(cycles),
+		    msg_bytes() - ls->bytes, ok ? "ok" : "FAIL");
+
+	return ok;
+}
+
+static bool rsp_equal(const struct net_buf_simple *rsp, const uint8_t *data, size_t len)
+{
+	return rsp->len == len && !memcmp(rsp->data, data, len);
+}
+
+static int cmd_bench_loopback(const struct shell *sh, size_t argc, char **argv)
+{
+	NET_BUF_SIMPLE_DEFINE_STATIC(ref, BT_MESH_VENDOR_MSG_MAXLEN_STATUS);
+	NET_BUF_SIMPLE_DEFINE_STATIC(buf, BT_MESH_VENDOR_MSG_MAXLEN_STATUS);
+	struct bt_mesh_vendor_cli *cli = model_handler_vendor_cli();
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = 0,
+		.app_idx = cli->pub.key,
+		.addr = bt_mesh_model_elem(cli->model)->rt->addr,
+		.send_ttl = 0,
+	};
+	struct bt_mesh_vendor_status rsp = { .buf = &buf };
+	struct loopback_step ls;
+	uint32_t failed = 0;
+	uint32_t version = 0;
+	int err;
+
+	if (!BT_MESH_ADDR_IS_UNICAST(ctx.addr)) {
+		shell_error(sh, "Not provisioned");
+		return -EAGAIN;
+	}
+
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (i * 151 + 17) ^ (i >> 3);
+	}
+
+	/* The full response of the local server, which every other response is checked against */
+	net_buf_simple_reset(&ref);
+	rsp.buf = &ref;
+	err = bt_mesh_vendor_cli_get(cli, &ctx, NULL, &rsp);
+	rsp.buf = &buf;
+	if (err) {
+		shell_error(sh, "No response from the local server (err: %d)", err);
+		return err;
+	}
+
+	shell_print(sh, "op,size,cycles,us,msg_bytes,result");
+
+	for (size_t s = 0; s < ARRAY_SIZE(vnd_bench_sizes); s++) {
+		struct bt_mesh_vendor_iov iov = {
+			.data = payload,
+			.len = vnd_bench_sizes[s],
+		};
+		struct bt_mesh_vendor_set set = {
+			.iov = &iov,
+			.iov_cnt = 1,
+		};
+
+		net_buf_simple_reset(&buf);
+		loopback_start(&ls);
+		err = bt_mesh_vendor_cli_set(cli, &ctx, &set, &rsp);
+		failed += !loopback_end(sh, &ls, "set", vnd_bench_sizes[s],
+					!err && rsp_equal(&buf, ref.data, ref.len));
+	}
+
+	for (size_t s = 0; s < ARRAY_SIZE(vnd_bench_sizes); s++) {
+		struct bt_mesh_vendor_get get = { .length = vnd_bench_sizes[s] };
+
+		net_buf_simple_reset(&buf);
+		loopback_start(&ls);
+		err = bt_mesh_vendor_cli_get(cli, &ctx, &get, &rsp);
+		failed += !loopback_end(sh, &ls, "get", vnd_bench_sizes[s],
+					!err && rsp_equal(&buf, ref.data, MIN(vnd_bench_sizes[s], ref.len)));
+	}
+
+	/* The first conditional GET has no version, so it gets the data, the second one doesn't */
+	net_buf_simple_reset(&buf);
+	loopback_start(&ls);
+	err = bt_mesh_vendor_cli_get_cond(cli, &ctx, NULL, &version, &rsp);
+	failed += !loopback_end(sh, &ls, "get_cond", ref.len,
+				!err && rsp_equal(&buf, ref.data, ref.len));
+
+	loopback_start(&ls);
+	err = bt_mesh_vendor_cli_get_cond(cli, &ctx, NULL, &version, &rsp);
+	failed += !loopback_end(sh, &ls, "get_cond", 0, err == -EALREADY);
+
+	/* The first SET establishes the base, the second one is sent as a delta to it */
+	for (int i = 0; i < 2; i++) {
+		net_buf_simple_reset(&buf);
+		payload[i] ^= 0xff;
+		loopback_start(&ls);
+		err = bt_mesh_vendor_cli_set_delta(cli, &ctx, payload, sizeof(payload), &rsp);
+		failed += !loopback_end(sh, &ls, "set_delta", sizeof(payload),
+					!err && rsp_equal(&buf, ref.data, ref.len));
+	}
+
+	/* Oversized payloads are rejected before anything is sent */
+	{
+		struct bt_mesh_vendor_iov iov[] = {
+			{ .data = payload, .len = sizeof(payload) },
+			{ .data = payload, .len = 1 },
+		};
+		struct bt_mesh_vendor_set set = {
+			.iov = iov,
+			.iov_cnt = ARRAY_SIZE(iov),
+		};
+
+		loopback_start(&ls);
+		err = bt_mesh_vendor_cli_set(cli, &ctx, &set, &rsp);
+		failed += !loopback_end(sh, &ls, "set", sizeof(payload) + 1, err == -EMSGSIZE);
+	}
+
+	if (failed) {
+		shell_error(sh, "%u checks failed", failed);
+		return -EIO;
+	}
+
+	shell_print(sh, "All checks passed");
+
+	return 0;
+}
+
+static int cmd_bench_run(const struct shell *sh, size_t argc, char **argv)
+{
+	struct bt_mesh_vendor_cli *cli = model_handler_vendor_cli();
+	uint16_t dst[BENCH_DST_MAX];
+	size_t dst_count = argc - 1;
+	int err = 0;
+
+	if (dst_count > ARRAY_SIZE(dst)) {
+		shell_error(sh, "At most %u destinations", BENCH_DST_MAX);
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < dst_count; i++) {
+		dst[i] = shell_strtoul(argv[i + 1], 16, &err);
+		if (err || dst[i] == BT_MESH_ADDR_UNASSIGNED) {
+			shell_error(sh, "Invalid address %s", argv[i + 1]);
+			return -EINVAL;
+		}
+	}
+
+	/* Mostly incompressible, so every size is sent as is */
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (i * 151 + 17) ^ (i >> 3);
+	}
+
+	shell_print(sh, VND_BENCH_CSV_HEADER);
+
+	for (size_t d = 0; d < dst_count; d++) {
+		for (size_t t = 0; t < ARRAY_SIZE(ttls); t++) {
+			for (size_t s = 0; s < ARRAY_SIZE(vnd_bench_sizes); s++) {
+				struct bt_mesh_msg_ctx ctx = {
+					.net_idx = 0,
+					.app_idx = cli->pub.key,
+					.addr = dst[d],
+					.send_ttl = ttls[t],
+				};
+				struct bt_mesh_vendor_iov iov = {
+					.data = payload,
+					.len = vnd_bench_sizes[s],
+				};
+				struct bt_mesh_vendor_set set = {
+					.iov = &iov,
+					.iov_cnt = 1,
+				};
+				struct vnd_bench_result res = { 0 };
+
+				vnd_bench_ack(cli, &ctx, &set, &res);
+				result_print(sh, &ctx, true, vnd_bench_sizes[s], &res);
+
+				vnd_bench_unack(cli, &ctx, &set, &res);
+				result_print(sh, &ctx, false, vnd_bench_sizes[s], &res);
+			}
+		}
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(vnd_bench_cmds,
+	SHELL_CMD_ARG(run, NULL,
+		      "Run the benchmark against unicast or group addresses, in hex <dst> [dst...]",
+		      cmd_bench_run, 2, BENCH_DST_MAX - 1),
+	SHELL_CMD(loopback, NULL, "Run the self-test against the node's own server",
+		  cmd_bench_loopback),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(vnd_bench, &vnd_bench_cmds, "Vendor model benchmark", NULL);
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef VND_BENCH_H__
+#define VND_BENCH_H__
+
+#include <zephyr/bluetooth/mesh.h>
+#include "vnd_cli.h"
+
+/** CSV header of the rows written by @ref vnd_bench_csv_row */
+#define VND_BENCH_CSV_HEADER                                                   \
+	"dst,ttl,mode,size,sent,delivered,elapsed_ms,msgs_per_s,goodput_Bps,"  \
+	"rtt_p50_ms,rtt_p99_ms,loss_pct"
+
+/** Payload sizes of a benchmark sweep */
+extern const uint16_t vnd_bench_sizes[8];
+
+/** Result of one benchmark step */
+struct vnd_bench_result {
+	/** Number of messages sent */
+	uint32_t sent;
+	/** Number of messages known to have arrived, or -1 if unknown */
+	int32_t delivered;
+	/** Duration of the step in milliseconds */
+	uint32_t elapsed;
+	/** Median round trip time in milliseconds */
+	uint16_t p50;
+	/** 99th percentile round trip time in milliseconds */
+	uint16_t p99;
+};
+
+/**
+ * @brief Send @kconfig{CONFIG_BT_MESH_VENDOR_BENCH_COUNT} acknowledged SETs
+ *
+ * Keeps @kconfig{CONFIG_BT_MESH_VENDOR_BENCH_WINDOW} requests in flight, and
+ * returns once every request has been answered or has timed out.
+ *
+ * @param cli Client to send from
+ * @param ctx Destination, application key and TTL
+ * @param set SET to send
+ * @param res Result of the step
+ */
+void vnd_bench_ack(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		   const struct bt_mesh_vendor_set *set, struct vnd_bench_result *res);
+
+/**
+ * @brief Send @kconfig{CONFIG_BT_MESH_VENDOR_BENCH_COUNT} unacknowledged SETs
+ *
+ * The number of messages delivered is asked from the statistics of unicast
+ * servers, and is unknown for groups and servers without statistics.
+ *
+ * @param cli Client to send from
+ * @param ctx Destination, application key and TTL
+ * @param set SET to send
+ * @param res Result of the step
+ */
+void vnd_bench_unack(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		     const struct bt_mesh_vendor_set *set, struct vnd_bench_result *res);
+
+/**
+ * @brief Format the result of a step as a CSV row, without a line ending
+ *
+ * @param buf  Buffer to write the row to
+ * @param len  Size of the buffer
+ * @param ctx  Destination and TTL of the step
+ * @param ack  Whether the step sent acknowledged SETs
+ * @param size Payload size of the step
+ * @param res  Result of the step
+ * @return Length of the row, as snprintk()
+ */
+int vnd_bench_csv_row(char *buf, size_t len, const struct bt_mesh_msg_ctx *ctx, bool ack,
+		      uint16_t size, const struct vnd_bench_result *res);
+
+#endif /* VND_BENCH_H__ */
@@ -4,143 +4,3873 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <string.h>
 #include <zephyr/bluetooth/mesh.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/crc.h>
 #include "../include/vnd_cli.h"
+#include "../include/vnd_pool.h"
+#include "../include/vnd_stats.h"
+#include "vnd_lz.h"
+#include "vnd_peer.h"
 #include <model_utils.h>
 
 LOG_MODULE_REGISTER(vnd_cli, CONFIG_BT_MESH_MODEL_LOG_LEVEL);
 
+/* An unassigned address matches any destination */
+static bool txn_matches(const struct bt_mesh_vendor_cli_txn *txn, uint8_t tid, uint16_t addr)
+{
+	/* Requests to group and virtual addresses are answered by the first server to respond */
+	return txn->busy && txn->tid == tid &&
+	       (addr == BT_MESH_ADDR_UNASSIGNED || !BT_MESH_ADDR_IS_UNICAST(txn->addr) ||
+		txn->addr == addr);
+}
+
+static bool tid_in_use(const struct bt_mesh_vendor_cli *cli, uint8_t tid)
+{
+	if (cli->collect.active && cli->collect.tid == tid) {
+		return true;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		if (cli->txn[i].busy && cli->txn[i].tid == tid) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Must be called with the client lock held */
+static uint8_t tid_next(struct bt_mesh_vendor_cli *cli)
+{
+	do {
+		cli->tid++;
+	} while (cli->tid == BT_MESH_VENDOR_TID_NONE || tid_in_use(cli, cli->tid));
+
+	return cli->tid;
+}
+
+static uint8_t tid_alloc(struct bt_mesh_vendor_cli *cli)
+{
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+	uint8_t tid = tid_next(cli);
+
+	k_spin_unlock(&cli->lock, key);
+
+	return tid;
+}
+
+/* Whether the timeouts of a request are running. They start once the send pacer has sent it. */
+static bool txn_running(const struct bt_mesh_vendor_cli_txn *txn)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	return txn->busy && !txn->queued;
+#else
+	return txn->busy;
+#endif
+}
+
+/* Schedule the timeout work for the earliest deadline in the table */
+static void txn_timer_update(struct bt_mesh_vendor_cli *cli)
+{
+	int64_t next = INT64_MAX;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		if (txn_running(&cli->txn[i])) {
+			next = MIN(next, cli->txn[i].deadline);
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	if (next == INT64_MAX) {
+		k_work_cancel_delayable(&cli->timeout_work);
+	} else {
+		k_work_reschedule(&cli->timeout_work, K_MSEC(MAX(next - k_uptime_get(), 0)));
+	}
+}
+
+/* Must be called with the client lock held */
+static struct bt_mesh_vendor_cli_txn *txn_compact_find(struct bt_mesh_vendor_cli *cli,
+							uint16_t addr)
+{
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		if (cli->txn[i].busy && cli->txn[i].compact &&
+		    (addr == cli->txn[i].addr || !BT_MESH_ADDR_IS_UNICAST(cli->txn[i].addr))) {
+			return &cli->txn[i];
+		}
+	}
+
+	return NULL;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+/* Entry of the server, moved to the front of the table. If the server has no entry and add is
+ * set, the least recently used entry is given to it. Must be called with the client lock held.
+ */
+static struct bt_mesh_vendor_cli_rtt *rtt_entry(struct bt_mesh_vendor_cli *cli, uint16_t addr,
+						bool add)
+{
+	struct bt_mesh_vendor_cli_rtt entry = { .addr = addr };
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cli->rtt); i++) {
+		if (cli->rtt[i].addr == addr) {
+			entry = cli->rtt[i];
+			break;
+		}
+	}
+
+	if (i == ARRAY_SIZE(cli->rtt)) {
+		if (!add) {
+			return NULL;
+		}
+
+		i--;
+	}
+
+	memmove(&cli->rtt[1], &cli->rtt[0], i * sizeof(cli->rtt[0]));
+	cli->rtt[0] = entry;
+
+	return &cli->rtt[0];
+}
+
+/* Timeout of the first attempt of a request, from the stack's estimate until the server has
+ * answered
+ */
+static uint32_t rtt_rto_get(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx)
+{
+	uint16_t addr = ctx ? ctx->addr : cli->pub.addr;
+	struct bt_mesh_vendor_cli_rtt *entry;
+	uint32_t rto = 0;
+	k_spinlock_key_t key;
+
+	if (BT_MESH_ADDR_IS_UNICAST(addr)) {
+		key = k_spin_lock(&cli->lock);
+		entry = rtt_entry(cli, addr, false);
+		if (entry) {
+			rto = entry->rto;
+		}
+		k_spin_unlock(&cli->lock, key);
+	}
+
+	return rto ? rto : model_ackd_timeout_get(cli->model, ctx);
+}
+
+/* Smoothed round trip time and variation, as in RFC 6298 */
+static void rtt_sample(struct bt_mesh_vendor_cli *cli, uint16_t addr, uint32_t rtt)
+{
+	struct bt_mesh_vendor_cli_rtt *entry;
+	k_spinlock_key_t key;
+
+	if (!BT_MESH_ADDR_IS_UNICAST(addr)) {
+		return;
+	}
+
+	key = k_spin_lock(&cli->lock);
+
+	entry = rtt_entry(cli, addr, true);
+	if (!entry->samples) {
+		entry->srtt = rtt;
+		entry->rttvar = rtt / 2;
+	} else {
+		uint32_t delta = entry->srtt > rtt ? entry->srtt - rtt : rtt - entry->srtt;
+
+		entry->rttvar = (3 * entry->rttvar + delta) / 4;
+		entry->srtt = (7 * entry->srtt + rtt) / 8;
+	}
+
+	entry->samples++;
+	entry->rto = CLAMP(entry->srtt + 4 * entry->rttvar, CONFIG_BT_MESH_VENDOR_CLI_RTO_MIN,
+			   CONFIG_BT_MESH_VENDOR_CLI_RTO_MAX);
+
+	k_spin_unlock(&cli->lock, key);
+}
+
+/* An attempt with the given timeout went unanswered, the next request waits twice as long */
+static void rtt_backoff(struct bt_mesh_vendor_cli *cli, uint16_t addr, uint32_t rto, bool last)
+{
+	struct bt_mesh_vendor_cli_rtt *entry;
+	k_spinlock_key_t key;
+
+	if (!BT_MESH_ADDR_IS_UNICAST(addr)) {
+		return;
+	}
+
+	key = k_spin_lock(&cli->lock);
+
+	entry = rtt_entry(cli, addr, true);
+	entry->rto = MIN(2 * rto, CONFIG_BT_MESH_VENDOR_CLI_RTO_MAX);
+	if (last) {
+		entry->timeouts++;
+	} else {
+		entry->retries++;
+	}
+
+	k_spin_unlock(&cli->lock, key);
+}
+
+/* Timeout of the given attempt of a request, doubled for every retry */
+static uint32_t txn_attempt_rto(const struct bt_mesh_vendor_cli_txn *txn, uint8_t attempt)
+{
+	return MIN((uint64_t)txn->rto << attempt, CONFIG_BT_MESH_VENDOR_CLI_RTO_MAX);
+}
+
+/* Up to an eighth off in either direction, so requests that timed out together aren't all
+ * sent again at the same time
+ */
+static uint32_t rto_jitter(uint32_t rto)
+{
+	return rto - rto / 8 + sys_rand32_get() % (rto / 4 + 1);
+}
+#endif
+
+/* Whether compact requests to the address are held back. Must be called with the client lock
+ * held.
+ */
+static bool compact_held(struct bt_mesh_vendor_cli *cli, uint16_t addr, int64_t now)
+{
+	for (int i = 0; i < ARRAY_SIZE(cli->compact_hold); i++) {
+		if (cli->compact_hold[i].addr == addr && cli->compact_hold[i].until > now &&
+		    addr != BT_MESH_ADDR_UNASSIGNED) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* A Vendor_Status_C that arrives after its request has ended can't be told apart from the
+ * answer to the next compact request to the same server. Send the server regular requests
+ * for another timeout, so a late answer finds no compact request to complete.
+ */
+static void compact_hold(struct bt_mesh_vendor_cli *cli, const struct bt_mesh_vendor_cli_txn *txn)
+{
+	int64_t now = k_uptime_get();
+	k_spinlock_key_t key;
+	int slot = 0;
+
+	if (!txn->compact) {
+		return;
+	}
+
+	key = k_spin_lock(&cli->lock);
+
+	/* Reuse the server's entry, or the one that expires first */
+	for (int i = 0; i < ARRAY_SIZE(cli->compact_hold); i++) {
+		if (cli->compact_hold[i].addr == txn->addr) {
+			slot = i;
+			break;
+		}
+
+		if (cli->compact_hold[i].until < cli->compact_hold[slot].until) {
+			slot = i;
+		}
+	}
+
+	cli->compact_hold[slot].addr = txn->addr;
+	cli->compact_hold[slot].until = now + txn->rto;
+
+	k_spin_unlock(&cli->lock, key);
+}
+
+/* Compact requests are matched by address only, so if compact is set and the destination
+ * already has one outstanding, it's cleared and the request must be sent in the regular form.
+ */
+static int txn_alloc(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx, uint32_t op,
+		     bt_mesh_vendor_cli_cb_t cb, void *user_data, bool *compact, uint8_t *tid)
+{
+	uint16_t addr = ctx ? ctx->addr : cli->pub.addr;
+	struct bt_mesh_vendor_cli_txn *txn = NULL;
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	uint32_t rto = rtt_rto_get(cli, ctx);
+#else
+	uint32_t rto = model_ackd_timeout_get(cli->model, ctx);
+#endif
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		if (!cli->txn[i].busy) {
+			txn = &cli->txn[i];
+			break;
+		}
+	}
+
+	if (compact && *compact &&
+	    (txn_compact_find(cli, addr) || compact_held(cli, addr, k_uptime_get()))) {
+		*compact = false;
+	}
+
+	if (txn) {
+		txn->tid = tid_next(cli);
+		txn->addr = addr;
+		txn->compact = compact && *compact;
+		txn->cb = cb;
+		txn->user_data = user_data;
+		txn->deadline = k_uptime_get() + rto;
+		txn->rto = rto;
+		txn->busy = true;
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+		txn->op = txn->compact ? BT_MESH_VENDOR_OP_SET_C : op;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STATS) || defined(CONFIG_BT_MESH_VENDOR_PACE) || \
+	defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+		txn->start = k_uptime_get();
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+		txn->queued = false;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+		txn->end = txn->deadline;
+		txn->retries = 0;
+		txn->len = 0;
+#endif
+		*tid = txn->tid;
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	if (!txn) {
+		return -EBUSY;
+	}
+
+	txn_timer_update(cli);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+/* Tokens are counted in thousandths of a segment, so a rate in segments per second refills
+ * the bucket by the rate every millisecond.
+ */
+#define PACE_TOKENS_PER_SEG 1000
+
+/* Failures closer together than this are taken as the same congestion event */
+#define PACE_HOLDOFF_MIN 250
+
+/* Number of transport segments a message takes on air */
+static uint32_t pace_segs(struct bt_mesh_vendor_cli *cli, const struct bt_mesh_msg_ctx *ctx,
+			  const struct net_buf_simple *msg)
+{
+	bool send_rel = ctx ? ctx->send_rel : cli->pub.send_rel;
+
+	if (!send_rel && msg->len <= BT_MESH_VENDOR_UNSEG_MAXLEN) {
+		return 1;
+	}
+
+	return DIV_ROUND_UP(msg->len + BT_MESH_MIC_SHORT, BT_MESH_APP_SEG_SDU_MAX);
+}
+
+/* Must be called with the client lock held */
+static void pace_refill(struct bt_mesh_vendor_cli *cli)
+{
+	int64_t now = k_uptime_get();
+	uint64_t tokens = cli->pace.tokens + (uint64_t)cli->pace.rate * (now - cli->pace.refill);
+
+	cli->pace.tokens = MIN(tokens, CONFIG_BT_MESH_VENDOR_PACE_BURST * PACE_TOKENS_PER_SEG);
+	cli->pace.refill = now;
+}
+
+/* Additive increase: one segment per second for every second's worth of segments sent at the
+ * current rate, unless round trip times are growing.
+ */
+static void pace_sent(struct bt_mesh_vendor_cli *cli, uint32_t segs)
+{
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	cli->pace.credit += segs;
+	if (cli->pace.credit >= cli->pace.rate) {
+		cli->pace.credit -= cli->pace.rate;
+		if (!cli->pace.rtt_rising && cli->pace.rate < CONFIG_BT_MESH_VENDOR_PACE_RATE_MAX) {
+			cli->pace.rate++;
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+}
+
+/* Multiplicative decrease, at most once per round trip */
+static void pace_congested(struct bt_mesh_vendor_cli *cli)
+{
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+	int64_t now = k_uptime_get();
+	uint16_t rate = cli->pace.rate;
+
+	if (now - cli->pace.decreased >= MAX(cli->pace.srtt, PACE_HOLDOFF_MIN)) {
+		cli->pace.rate = MAX(rate / 2, CONFIG_BT_MESH_VENDOR_PACE_RATE_MIN);
+		cli->pace.credit = 0;
+		cli->pace.decreased = now;
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	if (rate != cli->pace.rate) {
+		LOG_DBG("Congestion, rate %u -> %u segments/s", rate, cli->pace.rate);
+	}
+}
+
+static void pace_rtt_add(struct bt_mesh_vendor_cli *cli, uint32_t rtt)
+{
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	/* Queues building up along the path show as rising round trip times before anything is
+	 * lost, so the rate stops growing while they're well above the average.
+	 */
+	cli->pace.rtt_rising = cli->pace.srtt && rtt > cli->pace.srtt + cli->pace.srtt / 2;
+	cli->pace.srtt = cli->pace.srtt ? (7 * cli->pace.srtt + rtt) / 8 : rtt;
+
+	k_spin_unlock(&cli->lock, key);
+}
+
+static int pace_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *msg, uint32_t segs)
+{
+	int err;
+
+	_bt_mesh_vendor_stats_tx(msg);
+	err = bt_mesh_msg_send(cli->model, ctx, msg);
+	if (err == -ENOBUFS || err == -EBUSY) {
+		/* Out of advertising buffers or segmented transmit contexts */
+		pace_congested(cli);
+	} else if (!err) {
+		pace_sent(cli, segs);
+	}
+
+	return err;
+}
+
+/* Order the classes are served in, urgent first */
+static const uint8_t prio_rank[BT_MESH_VENDOR_PRIO_COUNT] = {
+	[BT_MESH_VENDOR_PRIO_URGENT] = 0,
+	[BT_MESH_VENDOR_PRIO_NORMAL] = 1,
+	[BT_MESH_VENDOR_PRIO_BULK] = 2,
+};
+
+/* Whether a message of the given class must wait behind queued messages. Must be called
+ * with the client lock held.
+ */
+static bool pace_blocked(struct bt_mesh_vendor_cli *cli, enum bt_mesh_vendor_prio prio)
+{
+	for (int i = 0; i < BT_MESH_VENDOR_PRIO_COUNT; i++) {
+		if (prio_rank[i] <= prio_rank[prio] && cli->pace.classes[i].queued) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Oldest message of the most urgent class in the queue. Must be called with the client lock
+ * held.
+ */
+static struct bt_mesh_vendor_cli_pace_msg *pace_next(struct bt_mesh_vendor_cli *cli)
+{
+	struct bt_mesh_vendor_cli_pace_msg *next = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(cli->pace.queue); i++) {
+		struct bt_mesh_vendor_cli_pace_msg *queued = &cli->pace.queue[i];
+
+		if (!queued->busy) {
+			continue;
+		}
+
+		if (!next || prio_rank[queued->prio] < prio_rank[next->prio] ||
+		    (queued->prio == next->prio && (int32_t)(queued->seq - next->seq) < 0)) {
+			next = queued;
+		}
+	}
+
+	return next;
+}
+
+/* Must be called with the client lock held */
+static void pace_class_sent(struct bt_mesh_vendor_cli *cli, enum bt_mesh_vendor_prio prio,
+			    uint32_t wait)
+{
+	struct bt_mesh_vendor_cli_pace_class *class = &cli->pace.classes[prio];
+
+	class->sent++;
+	class->wait_total += wait;
+	class->wait_max = MAX(class->wait_max, wait);
+}
+
+/* Mark whether a request waits in the queue. Must be called with the client lock held. */
+static struct bt_mesh_vendor_cli_txn *txn_queued_set(struct bt_mesh_vendor_cli *cli, uint8_t tid,
+						      bool queued)
+{
+	for (int i = 0; tid != BT_MESH_VENDOR_TID_NONE && i < ARRAY_SIZE(cli->txn); i++) {
+		if (txn_matches(&cli->txn[i], tid, BT_MESH_ADDR_UNASSIGNED)) {
+			cli->txn[i].queued = queued;
+			return &cli->txn[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Start the timeouts of a request once it's sent. They and its start time move by the time
+ * it waited in the queue, so the wait counts neither as round trip time nor as congestion.
+ */
+static void txn_sent(struct bt_mesh_vendor_cli *cli, uint8_t tid, uint32_t wait)
+{
+	struct bt_mesh_vendor_cli_txn *txn;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	txn = txn_queued_set(cli, tid, false);
+	if (txn) {
+		txn->deadline += wait;
+		txn->start += wait;
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+		txn->end += wait;
+#endif
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	if (txn) {
+		txn_timer_update(cli);
+	}
+}
+
+/* Send the queued messages as the bucket fills up, the most urgent first. A bulk message
+ * that's already been handed to the stack can't be preempted, so urgent messages wait for
+ * at most one message of another class.
+ */
+static void pace_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_mesh_vendor_cli *cli = CONTAINER_OF(dwork, struct bt_mesh_vendor_cli,
+						      pace.work);
+
+	while (true) {
+		void (*ready)(struct bt_mesh_vendor_cli *cli);
+		struct bt_mesh_vendor_cli_pace_msg *queued;
+		struct bt_mesh_msg_ctx ctx;
+		struct net_buf_simple msg;
+		k_spinlock_key_t key;
+		uint32_t segs;
+		uint32_t wait;
+		uint8_t tid;
+		bool pub;
+		int err;
+
+		key = k_spin_lock(&cli->lock);
+
+		queued = pace_next(cli);
+		if (!queued) {
+			ready = cli->pace.refused ? cli->pace.ready : NULL;
+			cli->pace.refused = false;
+			k_spin_unlock(&cli->lock, key);
+
+			if (ready) {
+				ready(cli);
+			}
+
+			return;
+		}
+
+		ctx = queued->ctx;
+		pub = queued->pub;
+		tid = queued->tid;
+		net_buf_simple_init_with_data(&msg, queued->data, sizeof(queued->data));
+		msg.len = queued->len;
+		segs = pace_segs(cli, pub ? NULL : &ctx, &msg);
+
+		pace_refill(cli);
+		if (cli->pace.tokens < segs * PACE_TOKENS_PER_SEG) {
+			wait = DIV_ROUND_UP(segs * PACE_TOKENS_PER_SEG - cli->pace.tokens,
+					    cli->pace.rate);
+			k_spin_unlock(&cli->lock, key);
+			k_work_schedule(&cli->pace.work, K_MSEC(wait));
+			return;
+		}
+
+		cli->pace.tokens -= segs * PACE_TOKENS_PER_SEG;
+		wait = k_uptime_get() - queued->queued;
+		pace_class_sent(cli, queued->prio, wait);
+		k_spin_unlock(&cli->lock, key);
+
+		/* The message stays in the queue while it's sent, so its slot isn't reused */
+		err = pace_send(cli, pub ? NULL : &ctx, &msg, segs);
+		if (err) {
+			LOG_WRN("Failed to send queued message (err: %d)", err);
+		}
+
+		txn_sent(cli, tid, wait);
+
+		key = k_spin_lock(&cli->lock);
+		cli->pace.classes[queued->prio].queued--;
+		cli->pace.count--;
+		queued->busy = false;
+		k_spin_unlock(&cli->lock, key);
+	}
+}
+#else
+static void pace_congested(struct bt_mesh_vendor_cli *cli) {}
+static void pace_rtt_add(struct bt_mesh_vendor_cli *cli, uint32_t rtt) {}
+#endif
+
+/* Send a message from the client. With pacing, messages beyond the token bucket wait in the
+ * queue, and are refused with -EAGAIN if it's full. The last free entry is kept for urgent
+ * messages. The timeouts of the request with the given TID wait along with it.
+ */
+static int msg_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		    struct net_buf_simple *msg, enum bt_mesh_vendor_prio prio, uint8_t tid)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	struct bt_mesh_vendor_cli_pace_msg *queued = NULL;
+	size_t limit = ARRAY_SIZE(cli->pace.queue);
+	uint32_t segs = pace_segs(cli, ctx, msg);
+	k_spinlock_key_t key;
+
+	if (prio >= BT_MESH_VENDOR_PRIO_COUNT) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&cli->lock);
+	pace_refill(cli);
+
+	/* Queued messages of the same class go first, so messages to the same destination stay
+	 * in order
+	 */
+	if (!pace_blocked(cli, prio) && cli->pace.tokens >= segs * PACE_TOKENS_PER_SEG) {
+		cli->pace.tokens -= segs * PACE_TOKENS_PER_SEG;
+		pace_class_sent(cli, prio, 0);
+		k_spin_unlock(&cli->lock, key);
+
+		return pace_send(cli, ctx, msg, segs);
+	}
+
+	if (prio != BT_MESH_VENDOR_PRIO_URGENT && limit > 1) {
+		limit--;
+	}
+
+	if (cli->pace.count < limit) {
+		for (int i = 0; i < ARRAY_SIZE(cli->pace.queue); i++) {
+			if (!cli->pace.queue[i].busy) {
+				queued = &cli->pace.queue[i];
+				break;
+			}
+		}
+	}
+
+	if (!queued) {
+		cli->pace.refused = true;
+		k_spin_unlock(&cli->lock, key);
+
+		return -EAGAIN;
+	}
+
+	queued->pub = !ctx;
+	if (ctx) {
+		queued->ctx = *ctx;
+	}
+
+	memcpy(queued->data, msg->data, msg->len);
+	queued->len = msg->len;
+	queued->prio = prio;
+	queued->tid = tid;
+	queued->seq = cli->pace.seq++;
+	queued->queued = k_uptime_get();
+	queued->busy = true;
+	(void)txn_queued_set(cli, tid, true);
+	cli->pace.classes[prio].queued++;
+	cli->pace.count++;
+
+	k_spin_unlock(&cli->lock, key);
+
+	LOG_DBG("Queued message, length %u class %u", msg->len, prio);
+
+	/* Doesn't move the work if it's already waiting for tokens */
+	k_work_schedule(&cli->pace.work, K_NO_WAIT);
+
+	return 0;
+#else
+	_bt_mesh_vendor_stats_tx(msg);
+
+	return bt_mesh_msg_send(cli->model, ctx, msg);
+#endif
+}
+
+/* Count a request that timed out against its opcode, and take it as a sign of congestion */
+static void txn_timeout_count(struct bt_mesh_vendor_cli *cli,
+			      const struct bt_mesh_vendor_cli_txn *txn)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	_bt_mesh_vendor_stats_timeout(txn->op);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	rtt_backoff(cli, txn->addr, txn_attempt_rto(txn, txn->retries), true);
+#endif
+	pace_congested(cli);
+}
+
+/* Record the round trip time of a request that got its response */
+static void txn_rtt_add(struct bt_mesh_vendor_cli *cli, const struct bt_mesh_vendor_cli_txn *txn)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_STATS) || defined(CONFIG_BT_MESH_VENDOR_PACE) || \
+	defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	uint32_t rtt = k_uptime_get() - txn->start;
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	/* The response to a request sent several times can't be matched to one attempt */
+	if (txn->retries) {
+		return;
+	}
+
+	rtt_sample(cli, txn->addr, rtt);
+#endif
+	_bt_mesh_vendor_stats_hist_add(BT_MESH_VENDOR_STATS_HIST_RTT, rtt);
+	pace_rtt_add(cli, rtt);
+#endif
+}
+
+/* Remove a pending transaction from the table. Once removed, nobody else will complete it.
+ * Returns false if the transaction isn't pending.
+ */
+static bool txn_take(struct bt_mesh_vendor_cli *cli, uint8_t tid, uint16_t addr,
+		     struct bt_mesh_vendor_cli_txn *out)
+{
+	bool found = false;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		if (txn_matches(&cli->txn[i], tid, addr)) {
+			*out = cli->txn[i];
+			cli->txn[i].busy = false;
+			found = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	return found;
+}
+
+/* Remove the first pending transaction whose deadline has passed at the given time, or any
+ * pending transaction if the time is negative.
+ */
+static bool txn_take_expired(struct bt_mesh_vendor_cli *cli, int64_t now,
+			     struct bt_mesh_vendor_cli_txn *out)
+{
+	bool found = false;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		if (cli->txn[i].busy &&
+		    (now < 0 || (txn_running(&cli->txn[i]) && cli->txn[i].deadline <= now))) {
+			*out = cli->txn[i];
+			cli->txn[i].busy = false;
+			found = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	return found;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+/* Keep a copy of a request, to send it again if it times out */
+static void txn_keep(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+		     const struct net_buf_simple *msg, enum bt_mesh_vendor_prio prio)
+{
+	k_spinlock_key_t key;
+
+	if (!CONFIG_BT_MESH_VENDOR_CLI_RETRIES || msg->len > sizeof(cli->txn[0].msg)) {
+		return;
+	}
+
+	key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		struct bt_mesh_vendor_cli_txn *txn = &cli->txn[i];
+
+		if (!txn_matches(txn, tid, BT_MESH_ADDR_UNASSIGNED)) {
+			continue;
+		}
+
+		/* The server can't tell a compact SET sent again from a new one, and would
+		 * apply it twice
+		 */
+		if (txn->compact) {
+			break;
+		}
+
+		memcpy(txn->msg, msg->data, msg->len);
+		txn->len = msg->len;
+		txn->prio = prio;
+		txn->pub = !ctx;
+		if (ctx) {
+			txn->ctx = *ctx;
+		}
+
+		/* Latest time the last attempt can time out, for blocking callers */
+		for (uint8_t n = 1; n <= CONFIG_BT_MESH_VENDOR_CLI_RETRIES; n++) {
+			uint32_t rto = txn_attempt_rto(txn, n);
+
+			txn->end += rto + rto / 8;
+		}
+
+		break;
+	}
+
+	k_spin_unlock(&cli->lock, key);
+}
+
+/* Find a request that has timed out and has retries left, and set it up for the next
+ * attempt. The request is copied out to be sent again.
+ */
+static bool txn_retry_take(struct bt_mesh_vendor_cli *cli, int64_t now,
+			   struct bt_mesh_vendor_cli_txn *out)
+{
+	bool found = false;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		struct bt_mesh_vendor_cli_txn *txn = &cli->txn[i];
+
+		if (txn_running(txn) && txn->deadline <= now && txn->len &&
+		    txn->retries < CONFIG_BT_MESH_VENDOR_CLI_RETRIES) {
+			txn->retries++;
+			txn->deadline = now + rto_jitter(txn_attempt_rto(txn, txn->retries));
+			*out = *txn;
+			found = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	return found;
+}
+
+static void txn_retry_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_vendor_cli_txn *txn)
+{
+	struct net_buf_simple msg;
+	int err;
+
+	LOG_DBG("Sending TID %u to 0x%04x again, attempt %u", txn->tid, txn->addr,
+		txn->retries + 1);
+
+	rtt_backoff(cli, txn->addr, txn_attempt_rto(txn, txn->retries - 1), false);
+	pace_congested(cli);
+
+	/* The stack encrypts the message in place, so the copy in the table is kept */
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (!err) {
+		net_buf_simple_add_mem(&msg, txn->msg, txn->len);
+		err = msg_send(cli, txn->pub ? NULL : &txn->ctx, &msg, txn->prio, txn->tid);
+		bt_mesh_vendor_pool_buf_put(&msg);
+	}
+
+	if (err) {
+		LOG_WRN("Failed to send TID %u again (err: %d)", txn->tid, err);
+	}
+}
+#endif
+
+/* Send a request, keeping a copy to send again if it times out */
+static int txn_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+		    struct net_buf_simple *msg, enum bt_mesh_vendor_prio prio)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	txn_keep(cli, ctx, tid, msg, prio);
+#endif
+
+	return msg_send(cli, ctx, msg, prio, tid);
+}
+
+static void txn_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_mesh_vendor_cli *cli = CONTAINER_OF(dwork, struct bt_mesh_vendor_cli,
+						      timeout_work);
+	struct bt_mesh_vendor_cli_txn txn;
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	while (txn_retry_take(cli, k_uptime_get(), &txn)) {
+		txn_retry_send(cli, &txn);
+	}
+#endif
+
+	while (txn_take_expired(cli, k_uptime_get(), &txn)) {
+		LOG_DBG("Transaction TID %u to 0x%04x timed out", txn.tid, txn.addr);
+		txn_timeout_count(cli, &txn);
+		compact_hold(cli, &txn);
+		txn.cb(cli, NULL, NULL, -ETIMEDOUT, txn.user_data);
+	}
+
+	txn_timer_update(cli);
+}
+
+/* Store a reply to the ongoing group GET. The copy is made with the lock held, so the caller's
+ * array is never written to after the collection has ended.
+ */
+static void collect_rx(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		       uint8_t tid, const struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli_reply *reply;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	if (!cli->collect.active || cli->collect.tid != tid) {
+		goto unlock;
+	}
+
+	for (size_t i = 0; i < cli->collect.count; i++) {
+		if (cli->collect.replies[i].addr == ctx->addr) {
+			/* Retransmitted by the server */
+			goto unlock;
+		}
+	}
+
+	reply = &cli->collect.replies[cli->collect.count++];
+	reply->addr = ctx->addr;
+
+	if (reply->buf) {
+		net_buf_simple_reset(reply->buf);
+		net_buf_simple_add_mem(reply->buf, buf->data,
+				       MIN(buf->len, net_buf_simple_tailroom(reply->buf)));
+	}
+
+	if (cli->collect.count == cli->collect.max) {
+		cli->collect.active = false;
+		k_sem_give(&cli->collect.done);
+	}
+
+unlock:
+	k_spin_unlock(&cli->lock, key);
+}
+
+static void status_rx(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		      uint8_t tid, struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_status status = {
+		.buf = buf,
+		.tid = tid,
+	};
+	struct bt_mesh_vendor_cli_txn txn;
+	struct net_buf_simple_state state;
+
+	LOG_DBG("Received STATUS message, TID %u data length %d", status.tid, buf->len);
+
+	if (txn_take(cli, status.tid, ctx->addr, &txn)) {
+		txn_rtt_add(cli, &txn);
+
+		/* Let the status handler see the data even if the callback consumes it */
+		net_buf_simple_save(buf, &state);
+		txn.cb(cli, ctx, &status, 0, txn.user_data);
+		net_buf_simple_restore(buf, &state);
+	}
+
+	collect_rx(cli, ctx, status.tid, buf);
+
+	if (cli->status_handler) {
+		cli->status_handler(cli, ctx, &status);
+	}
+}
+
 static int handle_status(const struct bt_mesh_model *model, \
 			 struct bt_mesh_msg_ctx *ctx, \
 			 struct net_buf_simple *buf)
 {
-	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
-	struct bt_mesh_vendor_status status;
-	struct bt_mesh_vendor_status *rsp;
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	uint8_t tid;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_STATUS, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+	status_rx(cli, ctx, tid, buf);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_LZ)
+static int handle_status_z(const struct bt_mesh_model *model, \
+			   struct bt_mesh_msg_ctx *ctx, \
+			   struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct net_buf_simple data;
+	uint8_t tid;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_STATUS_Z, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+
+	err = bt_mesh_vendor_pool_buf_get(&data);
+	if (err) {
+		return err;
+	}
+
+	err = vnd_lz_decompress_add(&data, buf);
+	if (!err && data.len > BT_MESH_VENDOR_MSG_MAXLEN_STATUS) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_STATUS_Z);
+		err = -EMSGSIZE;
+	}
+
+	if (err) {
+		LOG_WRN("Invalid compressed STATUS from 0x%04x", ctx->addr);
+	} else {
+		status_rx(cli, ctx, tid, &data);
+	}
+
+	bt_mesh_vendor_pool_buf_put(&data);
+
+	return err;
+}
+#endif
+
+/* A compact STATUS answers the compact request outstanding to its source */
+static int handle_status_c(const struct bt_mesh_model *model, \
+			   struct bt_mesh_msg_ctx *ctx, \
+			   struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_cli_txn *txn;
+	uint8_t tid = BT_MESH_VENDOR_TID_NONE;
+	k_spinlock_key_t key;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_STATUS_C, buf->len);
+
+	key = k_spin_lock(&cli->lock);
+	txn = txn_compact_find(cli, ctx->addr);
+	if (txn) {
+		tid = txn->tid;
+	}
+	k_spin_unlock(&cli->lock, key);
+
+	status_rx(cli, ctx, tid, buf);
+
+	return 0;
+}
+
+static int handle_not_modified(const struct bt_mesh_model *model, \
+			       struct bt_mesh_msg_ctx *ctx, \
+			       struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_cli_txn txn;
+	uint8_t tid;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_NOT_MODIFIED, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received NOT MODIFIED, TID %u", tid);
+
+	if (txn_take(cli, tid, ctx->addr, &txn)) {
+		txn_rtt_add(cli, &txn);
+		txn.cb(cli, ctx, NULL, -EALREADY, txn.user_data);
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CMD)
+/* Completion error of each command result */
+static const int cmd_result_err[] = {
+	[BT_MESH_VENDOR_CMD_SUCCESS] = 0,
+	[BT_MESH_VENDOR_CMD_UNKNOWN] = -ENOENT,
+	[BT_MESH_VENDOR_CMD_INVALID_LEN] = -EINVAL,
+	[BT_MESH_VENDOR_CMD_FAILED] = -EIO,
+};
+
+static int handle_cmd_status(const struct bt_mesh_model *model, \
+			     struct bt_mesh_msg_ctx *ctx, \
+			     struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_status status = {
+		.buf = buf,
+	};
+	struct bt_mesh_vendor_cli_txn txn;
+	uint8_t result;
+	uint8_t id;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_CMD_STATUS, buf->len);
+
+	status.tid = net_buf_simple_pull_u8(buf);
+	id = net_buf_simple_pull_u8(buf);
+	result = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received CMD STATUS 0x%02x, TID %u result %u", id, status.tid, result);
+
+	if (!txn_take(cli, status.tid, ctx->addr, &txn)) {
+		return 0;
+	}
+
+	txn_rtt_add(cli, &txn);
+
+	if (result == BT_MESH_VENDOR_CMD_SUCCESS) {
+		txn.cb(cli, ctx, &status, 0, txn.user_data);
+	} else {
+		txn.cb(cli, ctx, NULL,
+		       result < ARRAY_SIZE(cmd_result_err) ? cmd_result_err[result] : -EIO,
+		       txn.user_data);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+static int handle_delta_stale(const struct bt_mesh_model *model, \
+			      struct bt_mesh_msg_ctx *ctx, \
+			      struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_cli_txn txn;
+	uint8_t tid;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_DELTA_STALE, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received DELTA STALE, TID %u", tid);
+
+	if (txn_take(cli, tid, ctx->addr, &txn)) {
+		txn_rtt_add(cli, &txn);
+		txn.cb(cli, ctx, NULL, -ESTALE, txn.user_data);
+	}
+
+	return 0;
+}
+#endif
+
+static int handle_caps_status(const struct bt_mesh_model *model, \
+			      struct bt_mesh_msg_ctx *ctx, \
+			      struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	k_spinlock_key_t key;
+	uint8_t caps;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_CAPS_STATUS, buf->len);
+
+	caps = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received CAPS STATUS 0x%02x from 0x%04x", caps, ctx->addr);
+
+	key = k_spin_lock(&cli->lock);
+	vnd_peer_caps_set(cli->peers, ARRAY_SIZE(cli->peers), ctx->addr, caps);
+	k_spin_unlock(&cli->lock, key);
+
+	return 0;
+}
+
+static int handle_bulk_ack(const struct bt_mesh_model *model, \
+			   struct bt_mesh_msg_ctx *ctx, \
+			   struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_bulk_ack *ack;
+	struct bt_mesh_vendor_bulk_ack rx;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_BULK_ACK, buf->len);
+
+	err = bt_mesh_vendor_bulk_ack_decode(buf, &rx);
+	if (err) {
+		return err;
+	}
+
+	if (rx.id != cli->bulk.id ||
+	    !bt_mesh_msg_ack_ctx_match(&cli->bulk.ack_ctx, BT_MESH_VENDOR_OP_BULK_ACK,
+				       ctx->addr, (void **)&ack)) {
+		return 0;
+	}
+
+	*ack = rx;
+
+	LOG_DBG("Received BULK ACK, status %u base %u bitmap 0x%08x", ack->status, ack->base,
+		ack->bitmap);
+
+	bt_mesh_msg_ack_ctx_rx(&cli->bulk.ack_ctx);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+/* Statistics requested with a Vendor_Stats_Get */
+struct stats_rsp {
+	uint8_t kind;
+	uint8_t arg;
+	uint32_t *values;
+	size_t count;
+	int err;
+};
+
+static int handle_stats_status(const struct bt_mesh_model *model, \
+			       struct bt_mesh_msg_ctx *ctx, \
+			       struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct stats_rsp *rsp;
+	uint8_t kind;
+	uint8_t arg;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_STATS_STATUS, buf->len);
+
+	kind = net_buf_simple_pull_u8(buf);
+	arg = net_buf_simple_pull_u8(buf);
+
+	if (!bt_mesh_msg_ack_ctx_match(&cli->stats_ack, BT_MESH_VENDOR_OP_STATS_STATUS,
+				       ctx->addr, (void **)&rsp) ||
+	    rsp->kind != kind || rsp->arg != arg) {
+		return 0;
+	}
+
+	LOG_DBG("Received STATS STATUS %u/0x%02x, length %u", kind, arg, buf->len);
+
+	/* Nodes without the statistics only echo the request */
+	if (!buf->len) {
+		rsp->err = -ENOENT;
+	} else if (buf->len != rsp->count * sizeof(uint32_t)) {
+		rsp->err = -EINVAL;
+	} else {
+		for (size_t i = 0; i < rsp->count; i++) {
+			rsp->values[i] = net_buf_simple_pull_le32(buf);
+		}
+
+		rsp->err = 0;
+	}
+
+	bt_mesh_msg_ack_ctx_rx(&cli->stats_ack);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+static int handle_stream_nack(const struct bt_mesh_model *model, \
+			      struct bt_mesh_msg_ctx *ctx, \
+			      struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_stream_nack nack;
+	k_spinlock_key_t key;
+	uint32_t missing;
+	int dropped = 0;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_STREAM_NACK, buf->len);
+
+	err = bt_mesh_vendor_stream_nack_decode(buf, &nack);
+	if (err) {
+		return err;
+	}
+
+	LOG_DBG("Received STREAM NACK from 0x%04x, next %u missing 0x%08x", ctx->addr, nack.next,
+		nack.missing);
+
+	key = k_spin_lock(&cli->lock);
+
+	/* Every server in a group may ask, but only the server itself for a unicast stream */
+	if (!cli->stream.active || nack.id != cli->stream.id ||
+	    (!cli->stream.pub && BT_MESH_ADDR_IS_UNICAST(cli->stream.ctx.addr) &&
+	     ctx->addr != cli->stream.ctx.addr)) {
+		k_spin_unlock(&cli->lock, key);
+		return 0;
+	}
+
+	for (missing = nack.missing; missing; missing &= missing - 1) {
+		uint16_t seq = nack.next - find_lsb_set(missing);
+
+		/* Only the records still in the ring can be sent again */
+		if ((uint16_t)(cli->stream.seq - 1 - seq) < cli->stream.count) {
+			cli->stream.repair |= BIT(seq % BT_MESH_VENDOR_STREAM_WINDOW);
+		} else {
+			dropped++;
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	if (dropped) {
+		LOG_WRN("%d stream records asked for by 0x%04x are no longer kept", dropped,
+			ctx->addr);
+	}
+
+	k_work_submit(&cli->stream.repair_work);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_PAGE)
+/* Completion error of each page result */
+static const int page_result_err[] = {
+	[BT_MESH_VENDOR_PAGE_SUCCESS] = 0,
+	[BT_MESH_VENDOR_PAGE_NOT_SUPPORTED] = -ENOTSUP,
+	[BT_MESH_VENDOR_PAGE_OUT_OF_RANGE] = -ERANGE,
+	[BT_MESH_VENDOR_PAGE_FAILED] = -EIO,
+};
+
+static int handle_page_status(const struct bt_mesh_model *model, \
+			      struct bt_mesh_msg_ctx *ctx, \
+			      struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_status status = {
+		.buf = buf,
+	};
+	struct bt_mesh_vendor_cli_txn txn;
+	uint8_t result;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_PAGE_STATUS, buf->len);
+
+	status.tid = net_buf_simple_pull_u8(buf);
+	result = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received PAGE STATUS, TID %u result %u length %u", status.tid, result,
+		buf->len - 4);
+
+	if (!txn_take(cli, status.tid, ctx->addr, &txn)) {
+		return 0;
+	}
+
+	txn_rtt_add(cli, &txn);
+
+	/* The total length of the dataset is left in front of the page data */
+	if (result == BT_MESH_VENDOR_PAGE_SUCCESS) {
+		txn.cb(cli, ctx, &status, 0, txn.user_data);
+	} else {
+		txn.cb(cli, ctx, NULL,
+		       result < ARRAY_SIZE(page_result_err) ? page_result_err[result] : -EIO,
+		       txn.user_data);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+static int handle_kv_status(const struct bt_mesh_model *model, \
+			    struct bt_mesh_msg_ctx *ctx, \
+			    struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_status status = {
+		.buf = buf,
+	};
+	struct bt_mesh_vendor_cli_txn txn;
+	bt_mesh_vendor_cli_kv_handler_t handler;
+	struct bt_mesh_vendor_kv_rec_hdr hdr;
+	k_spinlock_key_t key;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_KV_STATUS, buf->len);
+
+	status.tid = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received KV STATUS, TID %u length %u", status.tid, buf->len);
+
+	/* The records are parsed by the request that asked for them. Only
+	 * publications are passed to the notification handler, a reply that
+	 * matches no request has timed out or been cancelled.
+	 */
+	if (status.tid != BT_MESH_VENDOR_TID_NONE) {
+		if (!txn_take(cli, status.tid, ctx->addr, &txn)) {
+			return 0;
+		}
+
+		txn_rtt_add(cli, &txn);
+		txn.cb(cli, ctx, &status, 0, txn.user_data);
+		return 0;
+	}
+
+	key = k_spin_lock(&cli->lock);
+	handler = cli->kv_handler;
+	k_spin_unlock(&cli->lock, key);
+
+	while (buf->len) {
+		err = bt_mesh_vendor_kv_rec_hdr_decode(buf, &hdr);
+		if (err || buf->len < hdr.len) {
+			return -EINVAL;
+		}
+
+		if (handler && hdr.len) {
+			handler(cli, ctx, hdr.key, buf->data, hdr.len);
+		}
+
+		net_buf_simple_pull(buf, hdr.len);
+	}
+
+	return 0;
+}
+
+static int handle_kv_set_status(const struct bt_mesh_model *model, \
+				struct bt_mesh_msg_ctx *ctx, \
+				struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_status status = {
+		.buf = buf,
+	};
+	struct bt_mesh_vendor_cli_txn txn;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_KV_SET_STATUS, buf->len);
+
+	status.tid = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received KV SET STATUS, TID %u, %u keys rejected", status.tid, buf->len);
+
+	if (!txn_take(cli, status.tid, ctx->addr, &txn)) {
+		return 0;
+	}
+
+	txn_rtt_add(cli, &txn);
+
+	/* The keys the server didn't write are left in the buffer */
+	txn.cb(cli, ctx, &status, 0, txn.user_data);
+
+	return 0;
+}
+#endif
+
+const struct bt_mesh_model_op _bt_mesh_vendor_cli_op[] = {
+	{
+		BT_MESH_VENDOR_OP_STATUS, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_STATUS),
+		handle_status
+	},
+	{
+		BT_MESH_VENDOR_OP_STATUS_C, BT_MESH_LEN_MIN(0), handle_status_c
+	},
+	{
+		BT_MESH_VENDOR_OP_BULK_ACK, BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_BULK_ACK),
+		handle_bulk_ack
+	},
+#if defined(CONFIG_BT_MESH_VENDOR_LZ)
+	{
+		BT_MESH_VENDOR_OP_STATUS_Z, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_STATUS),
+		handle_status_z
+	},
+#endif
+	{
+		BT_MESH_VENDOR_OP_NOT_MODIFIED,
+		BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_NOT_MODIFIED),
+		handle_not_modified
+	},
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	{
+		BT_MESH_VENDOR_OP_DELTA_STALE,
+		BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_DELTA_STALE),
+		handle_delta_stale
+	},
+#endif
+	{
+		BT_MESH_VENDOR_OP_CAPS_STATUS, BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_CAPS),
+		handle_caps_status
+	},
+#if defined(CONFIG_BT_MESH_VENDOR_CMD)
+	{
+		BT_MESH_VENDOR_OP_CMD_STATUS,
+		BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_CMD_STATUS),
+		handle_cmd_status
+	},
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	{
+		BT_MESH_VENDOR_OP_STATS_STATUS,
+		BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_STATS_STATUS),
+		handle_stats_status
+	},
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	{
+		BT_MESH_VENDOR_OP_STREAM_NACK,
+		BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_STREAM_NACK),
+		handle_stream_nack
+	},
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_PAGE)
+	{
+		BT_MESH_VENDOR_OP_PAGE_STATUS,
+		BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_PAGE_STATUS),
+		handle_page_status
+	},
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	{
+		BT_MESH_VENDOR_OP_KV_STATUS,
+		BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_KV_STATUS),
+		handle_kv_status
+	},
+	{
+		BT_MESH_VENDOR_OP_KV_SET_STATUS,
+		BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_KV_SET_STATUS),
+		handle_kv_set_status
+	},
+#endif
+	BT_MESH_MODEL_OP_END,
+};
+
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+static void batch_timeout(struct k_work *work);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+static void stream_repair(struct k_work *work);
+#endif
+
+static int vendor_cli_init(const struct bt_mesh_model *model)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+
+	cli->model = model;
+	cli->pub.msg = &cli->pub_msg;
+	net_buf_simple_init_with_data(&cli->pub_msg, cli->buf, sizeof(cli->buf));
+	k_work_init_delayable(&cli->timeout_work, txn_timeout);
+	bt_mesh_msg_ack_ctx_init(&cli->bulk.ack_ctx);
+	k_sem_init(&cli->bulk.tx_sem, 1, 1);
+	k_sem_init(&cli->collect.done, 0, 1);
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	bt_mesh_msg_ack_ctx_init(&cli->stats_ack);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+	k_work_init_delayable(&cli->batch.work, batch_timeout);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	k_work_init(&cli->stream.repair_work, stream_repair);
+	/* A restarted client doesn't continue the stream the server knows */
+	cli->stream.id = sys_rand8_get();
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	k_work_init_delayable(&cli->pace.work, pace_work);
+	cli->pace.rate = CONFIG_BT_MESH_VENDOR_PACE_RATE_INIT;
+	cli->pace.tokens = CONFIG_BT_MESH_VENDOR_PACE_BURST * PACE_TOKENS_PER_SEG;
+	cli->pace.refill = k_uptime_get();
+#endif
+
+	return 0;
+}
+
+static void vendor_cli_reset(const struct bt_mesh_model *model)
+{
+	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+	struct bt_mesh_vendor_cli_txn txn;
+	k_spinlock_key_t key;
+
+	net_buf_simple_reset(cli->pub.msg);
+
+	k_work_cancel_delayable(&cli->timeout_work);
+
+	/* A negative time matches every pending transaction */
+	while (txn_take_expired(cli, -1, &txn)) {
+		txn.cb(cli, NULL, NULL, -ECANCELED, txn.user_data);
+	}
+
+	key = k_spin_lock(&cli->lock);
+	if (cli->collect.active) {
+		cli->collect.active = false;
+		k_sem_give(&cli->collect.done);
+	}
+	k_spin_unlock(&cli->lock, key);
+
+	bt_mesh_msg_ack_ctx_reset(&cli->bulk.ack_ctx);
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	bt_mesh_msg_ack_ctx_reset(&cli->stats_ack);
+#endif
+	memset(cli->peers, 0, sizeof(cli->peers));
+	key = k_spin_lock(&cli->lock);
+	memset(cli->compact_hold, 0, sizeof(cli->compact_hold));
+	k_spin_unlock(&cli->lock, key);
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	key = k_spin_lock(&cli->lock);
+	memset(cli->rtt, 0, sizeof(cli->rtt));
+	k_spin_unlock(&cli->lock, key);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	key = k_spin_lock(&cli->lock);
+	memset(&cli->delta, 0, sizeof(cli->delta));
+	k_spin_unlock(&cli->lock, key);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+	k_work_cancel_delayable(&cli->batch.work);
+	key = k_spin_lock(&cli->lock);
+	memset(cli->batch.slots, 0, sizeof(cli->batch.slots));
+	k_spin_unlock(&cli->lock, key);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	(void)bt_mesh_vendor_cli_stream_stop(cli);
+	k_work_cancel(&cli->stream.repair_work);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	k_work_cancel_delayable(&cli->pace.work);
+	key = k_spin_lock(&cli->lock);
+	memset(cli->pace.queue, 0, sizeof(cli->pace.queue));
+	memset(cli->pace.classes, 0, sizeof(cli->pace.classes));
+	cli->pace.count = 0;
+	cli->pace.refused = false;
+	cli->pace.srtt = 0;
+	cli->pace.rtt_rising = false;
+	cli->pace.credit = 0;
+	cli->pace.rate = CONFIG_BT_MESH_VENDOR_PACE_RATE_INIT;
+	cli->pace.tokens = CONFIG_BT_MESH_VENDOR_PACE_BURST * PACE_TOKENS_PER_SEG;
+	cli->pace.refill = k_uptime_get();
+	k_spin_unlock(&cli->lock, key);
+#endif
+}
+
+const struct bt_mesh_model_cb _bt_mesh_vendor_cli_cb = {
+	.init = vendor_cli_init,
+	.reset = vendor_cli_reset,
+};
+
+/* Blocking request, waiting for the completion callback of an asynchronous one */
+struct sync_rsp {
+	struct k_sem sem;
+	struct bt_mesh_vendor_status *rsp;
+	int err;
+};
+
+static void sync_rsp_cb(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			const struct bt_mesh_vendor_status *status, int err, void *user_data)
+{
+	struct sync_rsp *sync = user_data;
+
+	sync->err = err;
+
+	if (!err) {
+		sync->rsp->tid = status->tid;
+		if (sync->rsp->buf) {
+			net_buf_simple_reset(sync->rsp->buf);
+			if (net_buf_simple_tailroom(sync->rsp->buf) < status->buf->len) {
+				sync->err = -ENOBUFS;
+			} else {
+				net_buf_simple_add_mem(sync->rsp->buf, status->buf->data,
+						       status->buf->len);
+			}
+		}
+	}
+
+	k_sem_give(&sync->sem);
+}
+
+/* Time until the last attempt of a request times out, or until the first attempt would time
+ * out if the request hasn't been sent yet. Negative if the request is no longer pending.
+ */
+static int32_t txn_wait_time(struct bt_mesh_vendor_cli *cli, uint8_t tid)
+{
+	int32_t wait = -1;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->txn); i++) {
+		const struct bt_mesh_vendor_cli_txn *txn = &cli->txn[i];
+
+		if (!txn_matches(txn, tid, BT_MESH_ADDR_UNASSIGNED)) {
+			continue;
+		}
+
+		if (!txn_running(txn)) {
+			wait = txn->rto;
+		} else {
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+			wait = MAX(txn->end - k_uptime_get(), 0);
+#else
+			wait = MAX(txn->deadline - k_uptime_get(), 0);
+#endif
+		}
+
+		break;
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	return wait;
+}
+
+static int sync_rsp_wait(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			 struct sync_rsp *sync, uint8_t tid)
+{
+	struct bt_mesh_vendor_cli_txn txn;
+	int32_t wait;
+
+	/* Don't rely on the timeout work, the caller may be blocking the workqueue it runs on.
+	 * The timeouts only start once the request is sent, so the wait is checked again.
+	 */
+	while ((wait = txn_wait_time(cli, tid)) > 0) {
+		if (!k_sem_take(&sync->sem, K_MSEC(wait))) {
+			return sync->err;
+		}
+	}
+
+	if (txn_take(cli, tid, BT_MESH_ADDR_UNASSIGNED, &txn)) {
+		txn_timeout_count(cli, &txn);
+		compact_hold(cli, &txn);
+		return -ETIMEDOUT;
+	}
+
+	/* Completed while timing out, the callback is about to give the semaphore */
+	k_sem_take(&sync->sem, K_FOREVER);
+
+	return sync->err;
+}
+
+static size_t set_len(const struct bt_mesh_vendor_set *set)
+{
+	size_t len = 0;
+
+	if (set->buf) {
+		return set->buf->len;
+	}
+
+	for (size_t i = 0; i < set->iov_cnt; i++) {
+		len += set->iov[i].len;
+	}
+
+	return len;
+}
+
+/* Write the payload straight into the outgoing message, so every byte is copied once */
+static void set_add(struct net_buf_simple *msg, const struct bt_mesh_vendor_set *set)
+{
+	if (set->buf) {
+		net_buf_simple_add_mem(msg, set->buf->data, set->buf->len);
+		return;
+	}
+
+	for (size_t i = 0; i < set->iov_cnt; i++) {
+		net_buf_simple_add_mem(msg, set->iov[i].data, set->iov[i].len);
+	}
+}
+
+static int caps_get_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx)
+{
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_CAPS_GET, BT_MESH_VENDOR_MSG_LEN_CAPS);
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_CAPS_GET);
+	net_buf_simple_add_u8(&msg, VND_CAPS_LOCAL);
+
+	LOG_DBG("Sending CAPS GET");
+
+	return msg_send(cli, ctx, &msg, BT_MESH_VENDOR_PRIO_NORMAL, BT_MESH_VENDOR_TID_NONE);
+}
+
+/* Capabilities of the destination, or zero if they're unknown. Unknown unicast destinations
+ * are asked for theirs, and the request also tells them ours.
+ */
+static uint8_t peer_caps(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx)
+{
+	uint16_t addr = ctx ? ctx->addr : cli->pub.addr;
+	int64_t now = k_uptime_get();
+	k_spinlock_key_t key;
+	bool ask;
+	int caps;
+
+	if (!IS_ENABLED(CONFIG_BT_MESH_VENDOR_LZ) || !BT_MESH_ADDR_IS_UNICAST(addr)) {
+		return 0;
+	}
+
+	key = k_spin_lock(&cli->lock);
+	/* Nodes without support never answer, so they're asked again only after a timeout */
+	ask = vnd_peer_caps_ask(cli->peers, ARRAY_SIZE(cli->peers), addr, now);
+	caps = vnd_peer_caps_get(cli->peers, ARRAY_SIZE(cli->peers), addr);
+	k_spin_unlock(&cli->lock, key);
+
+	if (ask) {
+		(void)caps_get_send(cli, ctx);
+	}
+
+	return MAX(caps, 0);
+}
+
+/* Compress the payload into the message. The compressor needs the payload in one piece, so
+ * multiple fragments are gathered in a pool buffer first.
+ */
+static int set_add_z(struct net_buf_simple *msg, const struct bt_mesh_vendor_set *set)
+{
+	struct net_buf_simple scratch;
+	int err;
+
+	if (set->buf) {
+		return vnd_lz_compress_add(msg, set->buf->data, set->buf->len);
+	}
+
+	if (set->iov_cnt == 1) {
+		return vnd_lz_compress_add(msg, set->iov[0].data, set->iov[0].len);
+	}
+
+	err = bt_mesh_vendor_pool_buf_get(&scratch);
+	if (err) {
+		return err;
+	}
+
+	set_add(&scratch, set);
+	err = vnd_lz_compress_add(msg, scratch.data, scratch.len);
+	bt_mesh_vendor_pool_buf_put(&scratch);
+
+	return err;
+}
+
+/* Build a SET or SET_UNACK message, compressed if the destination supports it and the
+ * compressed payload is shorter.
+ */
+static void set_build(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		      struct net_buf_simple *msg, const struct bt_mesh_vendor_set *set, bool ack,
+		      uint8_t tid)
+{
+	if (peer_caps(cli, ctx) & BT_MESH_VENDOR_CAP_LZ) {
+		bt_mesh_model_msg_init(msg, ack ? BT_MESH_VENDOR_OP_SET_Z :
+						  BT_MESH_VENDOR_OP_SET_UNACK_Z);
+		if (ack) {
+			net_buf_simple_add_u8(msg, tid);
+		}
+
+		if (!set_add_z(msg, set)) {
+			LOG_DBG("Compressed %zu bytes to %u", set_len(set), msg->len);
+			return;
+		}
+	}
+
+	bt_mesh_model_msg_init(msg, ack ? BT_MESH_VENDOR_OP_SET : BT_MESH_VENDOR_OP_SET_UNACK);
+	if (ack) {
+		net_buf_simple_add_u8(msg, tid);
+	}
+
+	set_add(msg, set);
+}
+
+static int set_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		    const struct bt_mesh_vendor_set *set, bool compact, uint8_t tid)
+{
+	struct net_buf_simple msg;
+	int err;
+
+	LOG_DBG("Sending SET%s message, TID %u data length %zu", compact ? " C" : "", tid,
+		set_len(set));
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	if (compact) {
+		bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_SET_C);
+		set_add(&msg, set);
+	} else {
+		set_build(cli, ctx, &msg, set, true, tid);
+	}
+
+	err = txn_send(cli, ctx, tid, &msg, set->prio);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+
+/* Send a GET, or a conditional GET if the version of the data the client has is given */
+static int get_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		    const struct bt_mesh_vendor_get *get, const uint32_t *version, uint8_t tid)
+{
+	/* Define buffer with enough space for the version and length parameters if present */
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_GET_COND,
+				 BT_MESH_VENDOR_MSG_MAXLEN_GET_COND);
+
+	/* Let the server learn our capabilities before it answers */
+	(void)peer_caps(cli, ctx);
+
+	if (version) {
+		LOG_DBG("Sending GET COND message, TID %u version 0x%08x", tid, *version);
+		bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_GET_COND);
+		net_buf_simple_add_u8(&msg, tid);
+		net_buf_simple_add_le32(&msg, *version);
+	} else {
+		bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_GET);
+		net_buf_simple_add_u8(&msg, tid);
+	}
+
+	/* Add optional length parameter if present */
+	if (get) {
+		LOG_DBG("Sending GET message, TID %u with length parameter: %u", tid,
+			get->length);
+		net_buf_simple_add_le16(&msg, get->length);
+	} else {
+		LOG_DBG("Sending GET message, TID %u without length parameter", tid);
+	}
+
+	return txn_send(cli, ctx, tid, &msg, BT_MESH_VENDOR_PRIO_NORMAL);
+}
+
+int bt_mesh_vendor_cli_set_async(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const struct bt_mesh_vendor_set *set,
+				 bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				 uint8_t *tid)
+{
+	struct bt_mesh_vendor_cli_txn txn;
+	uint8_t txn_tid;
+	bool compact;
+	int err;
+
+	if (!cb || !set) {
+		return -EINVAL;
+	}
+
+	if (set_len(set) > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_SET);
+		return -EMSGSIZE;
+	}
+
+	/* Small requests leave out the TID, so both they and their response have a byte more
+	 * room before they need to be segmented.
+	 */
+	compact = set_len(set) <= BT_MESH_VENDOR_MSG_MAXLEN_SET_C;
+
+	err = txn_alloc(cli, ctx, BT_MESH_VENDOR_OP_SET, cb, user_data, &compact, &txn_tid);
+	if (err) {
+		return err;
+	}
+
+	if (tid) {
+		*tid = txn_tid;
+	}
+
+	err = set_send(cli, ctx, set, compact, txn_tid);
+	if (err) {
+		txn_take(cli, txn_tid, BT_MESH_ADDR_UNASSIGNED, &txn);
+	}
+
+	return err;
+}
+
+static int get_async(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		     const struct bt_mesh_vendor_get *get, const uint32_t *version,
+		     bt_mesh_vendor_cli_cb_t cb, void *user_data, uint8_t *tid)
+{
+	struct bt_mesh_vendor_cli_txn txn;
+	uint8_t txn_tid;
+	int err;
+
+	if (!cb) {
+		return -EINVAL;
+	}
+
+	err = txn_alloc(cli, ctx, version ? BT_MESH_VENDOR_OP_GET_COND : BT_MESH_VENDOR_OP_GET, cb,
+			user_data, NULL, &txn_tid);
+	if (err) {
+		return err;
+	}
+
+	if (tid) {
+		*tid = txn_tid;
+	}
+
+	err = get_send(cli, ctx, get, version, txn_tid);
+	if (err) {
+		txn_take(cli, txn_tid, BT_MESH_ADDR_UNASSIGNED, &txn);
+	}
+
+	return err;
+}
+
+int bt_mesh_vendor_cli_get_async(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const struct bt_mesh_vendor_get *get,
+				 bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				 uint8_t *tid)
+{
+	return get_async(cli, ctx, get, NULL, cb, user_data, tid);
+}
+
+int bt_mesh_vendor_cli_get_cond_async(struct bt_mesh_vendor_cli *cli,
+				      struct bt_mesh_msg_ctx *ctx,
+				      const struct bt_mesh_vendor_get *get,
+				      uint32_t version,
+				      bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				      uint8_t *tid)
+{
+	return get_async(cli, ctx, get, &version, cb, user_data, tid);
+}
+
+int bt_mesh_vendor_cli_cancel(struct bt_mesh_vendor_cli *cli, uint8_t tid)
+{
+	struct bt_mesh_vendor_cli_txn txn;
+
+	if (!txn_take(cli, tid, BT_MESH_ADDR_UNASSIGNED, &txn)) {
+		return -ENOENT;
+	}
+
+	compact_hold(cli, &txn);
+	txn.cb(cli, NULL, NULL, -ECANCELED, txn.user_data);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CMD)
+static int cmd_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx, uint8_t id,
+		    const uint8_t *params, size_t len, uint8_t tid)
+{
+	struct net_buf_simple msg;
+	int err;
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_CMD);
+	net_buf_simple_add_u8(&msg, tid);
+	net_buf_simple_add_u8(&msg, id);
+	net_buf_simple_add_mem(&msg, params, len);
+
+	LOG_DBG("Sending CMD 0x%02x, TID %u parameter length %zu", id, tid, len);
+
+	err = txn_send(cli, ctx, tid, &msg, BT_MESH_VENDOR_PRIO_URGENT);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+#endif
+
+int bt_mesh_vendor_cli_cmd_async(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx, uint8_t cmd,
+				 const void *params, size_t len,
+				 bt_mesh_vendor_cli_cb_t cb, void *user_data,
+				 uint8_t *tid)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_CMD)
+	struct bt_mesh_vendor_cli_txn txn;
+	uint8_t txn_tid;
+	int err;
+
+	if (!cb || (len && !params)) {
+		return -EINVAL;
+	}
+
+	if (len > BT_MESH_VENDOR_CMD_PARAMS_MAXLEN) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_CMD);
+		return -EMSGSIZE;
+	}
+
+	err = txn_alloc(cli, ctx, BT_MESH_VENDOR_OP_CMD, cb, user_data, NULL, &txn_tid);
+	if (err) {
+		return err;
+	}
+
+	if (tid) {
+		*tid = txn_tid;
+	}
+
+	err = cmd_send(cli, ctx, cmd, params, len, txn_tid);
+	if (err) {
+		txn_take(cli, txn_tid, BT_MESH_ADDR_UNASSIGNED, &txn);
+	}
+
+	return err;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_cmd(struct bt_mesh_vendor_cli *cli,
+			   struct bt_mesh_msg_ctx *ctx, uint8_t cmd,
+			   const void *params, size_t len,
+			   struct bt_mesh_vendor_status *rsp)
+{
+	struct bt_mesh_vendor_status status = { 0 };
+	struct sync_rsp sync = { .rsp = rsp ? rsp : &status };
+	uint8_t tid;
+	int err;
+
+	k_sem_init(&sync.sem, 0, 1);
+
+	err = bt_mesh_vendor_cli_cmd_async(cli, ctx, cmd, params, len, sync_rsp_cb, &sync, &tid);
+	if (err) {
+		return err;
+	}
+
+	return sync_rsp_wait(cli, ctx, &sync, tid);
+}
+
+int bt_mesh_vendor_cli_set(struct bt_mesh_vendor_cli *cli,
+			   struct bt_mesh_msg_ctx *ctx,
+			   const struct bt_mesh_vendor_set *set,
+			   struct bt_mesh_vendor_status *rsp)
+{
+	struct sync_rsp sync = { .rsp = rsp };
+	uint8_t tid;
+	int err;
+
+	if (set_len(set) > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_SET);
+		return -EMSGSIZE;
+	}
+
+	if (!rsp) {
+		return set_send(cli, ctx, set, false, tid_alloc(cli));
+	}
+
+	k_sem_init(&sync.sem, 0, 1);
+
+	err = bt_mesh_vendor_cli_set_async(cli, ctx, set, sync_rsp_cb, &sync, &tid);
+	if (err) {
+		return err;
+	}
+
+	return sync_rsp_wait(cli, ctx, &sync, tid);
+}
+
+int bt_mesh_vendor_cli_get(struct bt_mesh_vendor_cli *cli,
+			   struct bt_mesh_msg_ctx *ctx,
+			   const struct bt_mesh_vendor_get *get,
+			   struct bt_mesh_vendor_status *rsp)
+{
+	struct sync_rsp sync = { .rsp = rsp };
+	uint8_t tid;
+	int err;
+
+	if (!rsp) {
+		return get_send(cli, ctx, get, NULL, tid_alloc(cli));
+	}
+
+	k_sem_init(&sync.sem, 0, 1);
+
+	err = bt_mesh_vendor_cli_get_async(cli, ctx, get, sync_rsp_cb, &sync, &tid);
+	if (err) {
+		return err;
+	}
+
+	return sync_rsp_wait(cli, ctx, &sync, tid);
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+/* Must be called with the client lock held */
+static struct bt_mesh_vendor_cli_image *image_find(struct bt_mesh_vendor_cli *cli, uint16_t addr)
+{
+	for (int i = 0; i < ARRAY_SIZE(cli->delta.images); i++) {
+		if (cli->delta.images[i].addr == addr) {
+			return &cli->delta.images[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Make the acknowledged payload the base of the next delta to the server, replacing the
+ * least recently used image if the server doesn't have one.
+ */
+static void image_store(struct bt_mesh_vendor_cli *cli, uint16_t addr, const uint8_t *data,
+			size_t len, uint32_t version)
+{
+	struct bt_mesh_vendor_cli_image *image;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	image = image_find(cli, addr);
+	if (!image) {
+		image = &cli->delta.images[0];
+
+		for (int i = 1; i < ARRAY_SIZE(cli->delta.images); i++) {
+			if (cli->delta.images[i].seq < image->seq) {
+				image = &cli->delta.images[i];
+			}
+		}
+	}
+
+	image->addr = addr;
+	image->len = len;
+	image->version = version;
+	image->seq = ++cli->delta.seq;
+	memcpy(image->data, data, len);
+
+	k_spin_unlock(&cli->lock, key);
+}
+
+/* Add the byte ranges that differ from the image to the message. Unchanged gaps shorter than
+ * a range header are sent along with the range they're in.
+ */
+static int delta_ranges_add(struct net_buf_simple *msg,
+			    const struct bt_mesh_vendor_cli_image *image,
+			    const uint8_t *data, size_t len)
+{
+	size_t ranges_len = 0;
+	size_t i = 0;
+
+	while (i < len) {
+		size_t end = i;
+
+		if (i < image->len && data[i] == image->data[i]) {
+			i++;
+			continue;
+		}
+
+		for (size_t j = i; j < len && j - i < UINT8_MAX; j++) {
+			if (j >= image->len || data[j] != image->data[j]) {
+				end = j + 1;
+			} else if (j - end >= BT_MESH_VENDOR_DELTA_RANGE_HDR_LEN) {
+				break;
+			}
+		}
+
+		/* The delta must be shorter than the SET it replaces, headers included */
+		ranges_len += BT_MESH_VENDOR_DELTA_RANGE_HDR_LEN + end - i;
+		if (BT_MESH_VENDOR_MSG_MINLEN_SET_DELTA + ranges_len >=
+		    BT_MESH_VENDOR_TID_LEN + len) {
+			return -ENOSPC;
+		}
+
+		net_buf_simple_add_le16(msg, i);
+		net_buf_simple_add_u8(msg, end - i);
+		net_buf_simple_add_mem(msg, &data[i], end - i);
+		i = end;
+	}
+
+	return 0;
+}
+
+/* Build a delta SET against the image of the server. Returns -ENOENT if there is no image,
+ * or -ENOSPC if the delta isn't shorter than a full SET.
+ */
+static int delta_build(struct bt_mesh_vendor_cli *cli, uint16_t addr,
+		       struct net_buf_simple *msg, const uint8_t *data, size_t len,
+		       uint32_t version, uint8_t tid)
+{
+	struct bt_mesh_vendor_cli_image *image;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+	int err;
+
+	image = image_find(cli, addr);
+	if (!image) {
+		k_spin_unlock(&cli->lock, key);
+		return -ENOENT;
+	}
+
+	image->seq = ++cli->delta.seq;
+
+	bt_mesh_model_msg_init(msg, BT_MESH_VENDOR_OP_SET_DELTA);
+	net_buf_simple_add_u8(msg, tid);
+	net_buf_simple_add_le32(msg, image->version);
+	net_buf_simple_add_le32(msg, version);
+	net_buf_simple_add_le16(msg, len);
+	err = delta_ranges_add(msg, image, data, len);
+
+	k_spin_unlock(&cli->lock, key);
+
+	return err;
+}
+
+static int delta_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		      uint16_t addr, const uint8_t *data, size_t len, uint32_t version,
+		      struct sync_rsp *sync)
+{
+	struct bt_mesh_vendor_cli_txn txn;
+	struct net_buf_simple msg;
+	uint8_t tid;
+	int err;
+
+	err = txn_alloc(cli, ctx, BT_MESH_VENDOR_OP_SET_DELTA, sync_rsp_cb, sync, NULL, &tid);
+	if (err) {
+		return err;
+	}
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (!err) {
+		err = delta_build(cli, addr, &msg, data, len, version, tid);
+		if (!err) {
+			LOG_DBG("Sending SET DELTA, TID %u data length %zu as %u", tid, len,
+				msg.len);
+			err = txn_send(cli, ctx, tid, &msg, BT_MESH_VENDOR_PRIO_NORMAL);
+		}
+
+		bt_mesh_vendor_pool_buf_put(&msg);
+	}
+
+	if (err) {
+		txn_take(cli, tid, BT_MESH_ADDR_UNASSIGNED, &txn);
+		return err;
+	}
+
+	return sync_rsp_wait(cli, ctx, sync, tid);
+}
+#endif
+
+int bt_mesh_vendor_cli_set_delta(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const uint8_t *data, size_t len,
+				 struct bt_mesh_vendor_status *rsp)
+{
+	struct bt_mesh_vendor_status status = { 0 };
+	struct sync_rsp sync = { .rsp = rsp ? rsp : &status };
+	struct bt_mesh_vendor_iov iov = {
+		.data = data,
+		.len = len,
+	};
+	struct bt_mesh_vendor_set set = {
+		.iov = &iov,
+		.iov_cnt = 1,
+	};
+
+	if (len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_SET_DELTA);
+		return -EMSGSIZE;
+	}
+
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	int err;
+	uint16_t addr = ctx ? ctx->addr : cli->pub.addr;
+	struct net_buf_simple payload = {
+		.data = (uint8_t *)data,
+		.len = len,
+	};
+	uint32_t version = bt_mesh_vendor_version(&payload);
+
+	if (!BT_MESH_ADDR_IS_UNICAST(addr)) {
+		return bt_mesh_vendor_cli_set(cli, ctx, &set, sync.rsp);
+	}
+
+	k_sem_init(&sync.sem, 0, 1);
+
+	err = delta_send(cli, ctx, addr, data, len, version, &sync);
+	if (err == -ENOENT || err == -ENOSPC || err == -ESTALE) {
+		LOG_DBG("Sending full SET instead of delta (err: %d)", err);
+		err = bt_mesh_vendor_cli_set(cli, ctx, &set, sync.rsp);
+	}
+
+	if (!err) {
+		image_store(cli, addr, data, len, version);
+	}
+
+	return err;
+#else
+	return bt_mesh_vendor_cli_set(cli, ctx, &set, sync.rsp);
+#endif
+}
+
+int bt_mesh_vendor_cli_get_cond(struct bt_mesh_vendor_cli *cli,
+				struct bt_mesh_msg_ctx *ctx,
+				const struct bt_mesh_vendor_get *get,
+				uint32_t *version,
+				struct bt_mesh_vendor_status *rsp)
+{
+	struct sync_rsp sync = { .rsp = rsp };
+	uint8_t tid;
+	int err;
+
+	if (!version || !rsp || !rsp->buf) {
+		return -EINVAL;
+	}
+
+	k_sem_init(&sync.sem, 0, 1);
+
+	err = bt_mesh_vendor_cli_get_cond_async(cli, ctx, get, *version, sync_rsp_cb, &sync,
+						&tid);
+	if (err) {
+		return err;
+	}
+
+	err = sync_rsp_wait(cli, ctx, &sync, tid);
+	if (!err) {
+		*version = bt_mesh_vendor_version(rsp->buf);
+	}
+
+	return err;
+}
+
+int bt_mesh_vendor_cli_get_collect(struct bt_mesh_vendor_cli *cli,
+				   struct bt_mesh_msg_ctx *ctx,
+				   const struct bt_mesh_vendor_get *get,
+				   struct bt_mesh_vendor_cli_reply *replies,
+				   size_t max, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	uint8_t tid;
+	size_t count;
+	int err;
+
+	if (!replies || !max) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&cli->lock);
+	if (cli->collect.active) {
+		k_spin_unlock(&cli->lock, key);
+		return -EBUSY;
+	}
+
+	tid = tid_next(cli);
+	cli->collect.replies = replies;
+	cli->collect.max = max;
+	cli->collect.count = 0;
+	cli->collect.tid = tid;
+	cli->collect.active = true;
+	k_sem_reset(&cli->collect.done);
+	k_spin_unlock(&cli->lock, key);
+
+	err = get_send(cli, ctx, get, NULL, tid);
+	if (!err) {
+		(void)k_sem_take(&cli->collect.done, timeout);
+	}
+
+	key = k_spin_lock(&cli->lock);
+	cli->collect.active = false;
+	count = cli->collect.count;
+	k_spin_unlock(&cli->lock, key);
+
+	LOG_DBG("Collected %zu STATUS replies to TID %u (err: %d)", count, tid, err);
+
+	return err ? err : count;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_PAGE)
+struct page_xfer;
+
+/* Page request of an ongoing dataset read */
+struct page_req {
+	struct page_xfer *xfer;
+	uint32_t offset;
+	uint8_t tid;
+	/* Only changed by the reading thread */
+	bool busy;
+	/* Set under the lock of the read when the request completes */
+	bool done;
+};
+
+/* Blocking dataset read, with several page requests in flight */
+struct page_xfer {
+	struct k_sem sem;
+	struct k_spinlock lock;
+	uint8_t *buf;
+	size_t size;
+	uint32_t total;
+	bool total_known;
+	int err;
+	struct page_req reqs[CONFIG_BT_MESH_VENDOR_PAGE_WINDOW];
+};
+
+static void page_done(struct page_xfer *xfer, struct page_req *req, int err)
+{
+	k_spinlock_key_t key = k_spin_lock(&xfer->lock);
+
+	if (err && !xfer->err) {
+		xfer->err = err;
+	}
+
+	req->done = true;
+	k_spin_unlock(&xfer->lock, key);
+
+	k_sem_give(&xfer->sem);
+}
+
+static void page_rsp_cb(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			const struct bt_mesh_vendor_status *status, int err, void *user_data)
+{
+	struct page_req *req = user_data;
+	struct page_xfer *xfer = req->xfer;
+	k_spinlock_key_t key;
+	uint32_t total;
+	bool changed;
+
+	/* Only offsets inside the dataset are asked for, so it has shrunk since */
+	if (err == -ERANGE) {
+		err = -ESTALE;
+	}
+
+	if (err) {
+		page_done(xfer, req, err);
+		return;
+	}
+
+	total = net_buf_simple_pull_le32(status->buf);
+
+	key = k_spin_lock(&xfer->lock);
+	if (!xfer->total_known) {
+		xfer->total = total;
+		xfer->total_known = true;
+	}
+
+	/* Every page is read at its own time, the dataset must not change length in between */
+	changed = (total != xfer->total);
+	k_spin_unlock(&xfer->lock, key);
+
+	if (changed) {
+		err = -ESTALE;
+	} else if (req->offset > total ||
+		   status->buf->len != MIN(CONFIG_BT_MESH_VENDOR_PAGE_SIZE, total - req->offset)) {
+		err = -EBADMSG;
+	} else if (req->offset < xfer->size) {
+		memcpy(&xfer->buf[req->offset], status->buf->data,
+		       MIN(status->buf->len, xfer->size - req->offset));
+	}
+
+	page_done(xfer, req, err);
+}
+
+static int page_get_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			 struct page_req *req)
+{
+	struct bt_mesh_vendor_get_page get = {
+		.offset = req->offset,
+		.len = CONFIG_BT_MESH_VENDOR_PAGE_SIZE,
+	};
+	struct bt_mesh_vendor_cli_txn txn;
+	int err;
+
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_GET_PAGE,
+				 BT_MESH_VENDOR_MSG_LEN_GET_PAGE);
+
+	err = txn_alloc(cli, ctx, BT_MESH_VENDOR_OP_GET_PAGE, page_rsp_cb, req, NULL, &get.tid);
+	if (err) {
+		return err;
+	}
+
+	req->tid = get.tid;
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_GET_PAGE);
+	(void)bt_mesh_vendor_get_page_encode(&msg, &get);
+
+	LOG_DBG("Sending GET PAGE, TID %u offset %u", get.tid, get.offset);
+
+	err = txn_send(cli, ctx, get.tid, &msg, BT_MESH_VENDOR_PRIO_BULK);
+	if (err) {
+		txn_take(cli, get.tid, BT_MESH_ADDR_UNASSIGNED, &txn);
+	}
+
+	return err;
+}
+
+/* Take the page requests still in flight from the table and complete them with an error.
+ * Only the first is counted as a timeout, the rest are given up along with it.
+ */
+static void page_abort(struct bt_mesh_vendor_cli *cli, struct page_xfer *xfer, int err)
+{
+	struct bt_mesh_vendor_cli_txn txn;
+	bool counted = false;
+
+	for (int i = 0; i < ARRAY_SIZE(xfer->reqs); i++) {
+		struct page_req *req = &xfer->reqs[i];
+		k_spinlock_key_t key = k_spin_lock(&xfer->lock);
+		bool pending = req->busy && !req->done;
+
+		k_spin_unlock(&xfer->lock, key);
+
+		if (!pending || !txn_take(cli, req->tid, BT_MESH_ADDR_UNASSIGNED, &txn)) {
+			continue;
+		}
+
+		if (err == -ETIMEDOUT && !counted) {
+			txn_timeout_count(cli, &txn);
+			counted = true;
+		}
+
+		page_done(xfer, req, err);
+	}
+}
+
+/* Time until the first page request in flight makes its last attempt. Requests that are no
+ * longer pending are about to give the semaphore, and aren't waited for.
+ */
+static int32_t page_wait_time(struct bt_mesh_vendor_cli *cli, struct page_xfer *xfer)
+{
+	int32_t wait = INT32_MAX;
+
+	for (int i = 0; i < ARRAY_SIZE(xfer->reqs); i++) {
+		struct page_req *req = &xfer->reqs[i];
+		k_spinlock_key_t key = k_spin_lock(&xfer->lock);
+		bool pending = req->busy && !req->done;
+
+		k_spin_unlock(&xfer->lock, key);
+
+		if (pending) {
+			int32_t req_wait = txn_wait_time(cli, req->tid);
+
+			if (req_wait >= 0) {
+				wait = MIN(wait, req_wait);
+			}
+		}
+	}
+
+	return wait;
+}
+
+static struct page_req *page_req_free(struct page_xfer *xfer)
+{
+	for (int i = 0; i < ARRAY_SIZE(xfer->reqs); i++) {
+		if (!xfer->reqs[i].busy) {
+			return &xfer->reqs[i];
+		}
+	}
+
+	return NULL;
+}
+#endif
+
+int bt_mesh_vendor_cli_get_object(struct bt_mesh_vendor_cli *cli,
+				  struct bt_mesh_msg_ctx *ctx,
+				  void *buf, size_t size, size_t *total)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_PAGE)
+	struct page_xfer xfer = {
+		.buf = buf,
+		.size = size,
+	};
+	k_spinlock_key_t key;
+	struct page_req *req;
+	uint32_t next = 0;
+	size_t end = 0;
+	int inflight = 0;
+	int32_t wait;
+	bool taken;
+	int err = 0;
+
+	if (!ctx || !BT_MESH_ADDR_IS_UNICAST(ctx->addr) || (size && !buf)) {
+		return -EINVAL;
+	}
+
+	k_sem_init(&xfer.sem, 0, ARRAY_SIZE(xfer.reqs));
+
+	for (int i = 0; i < ARRAY_SIZE(xfer.reqs); i++) {
+		xfer.reqs[i].xfer = &xfer;
+	}
+
+	for (;;) {
+		/* The first page tells the length of the dataset, the rest are asked for together */
+		while (!err && (next == 0 || next < end) &&
+		       (req = page_req_free(&xfer))) {
+			req->offset = next;
+			req->done = false;
+			req->busy = true;
+
+			err = page_get_send(cli, ctx, req);
+			if (err) {
+				req->busy = false;
+				/* Out of transactions, wait for one of ours to complete */
+				if (err == -EBUSY && inflight) {
+					err = 0;
+				}
+
+				break;
+			}
+
+			inflight++;
+			next += CONFIG_BT_MESH_VENDOR_PAGE_SIZE;
+		}
+
+		if (err) {
+			page_abort(cli, &xfer, err);
+		}
+
+		if (!inflight) {
+			break;
+		}
+
+		/* Don't rely on the timeout work, the caller may be blocking the workqueue it
+		 * runs on. The timeouts only start once the requests are sent, so the wait is
+		 * checked again.
+		 */
+		do {
+			wait = page_wait_time(cli, &xfer);
+			taken = !k_sem_take(&xfer.sem, K_MSEC(wait));
+		} while (!taken && wait);
+
+		if (!taken) {
+			page_abort(cli, &xfer, -ETIMEDOUT);
+
+			/* Completed or given up, a request is about to give the semaphore */
+			k_sem_take(&xfer.sem, K_FOREVER);
+		}
+
+		key = k_spin_lock(&xfer.lock);
+		for (int i = 0; i < ARRAY_SIZE(xfer.reqs); i++) {
+			if (xfer.reqs[i].busy && xfer.reqs[i].done) {
+				xfer.reqs[i].busy = false;
+				inflight--;
+			}
+		}
+
+		if (!err) {
+			err = xfer.err;
+		}
+
+		end = xfer.total_known ? MIN(xfer.total, size) : 0;
+		k_spin_unlock(&xfer.lock, key);
+	}
+
+	LOG_DBG("Read %zu of %u bytes from 0x%04x (err: %d)", end, xfer.total, ctx->addr, err);
+
+	if (!err && total) {
+		*total = xfer.total;
+	}
+
+	return err;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+static size_t kv_recs_len(const struct bt_mesh_vendor_kv_rec *recs, size_t count)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		len += BT_MESH_VENDOR_KV_REC_HDR_LEN + recs[i].len;
+	}
+
+	return len;
+}
+
+static void kv_recs_add(struct net_buf_simple *msg, const struct bt_mesh_vendor_kv_rec *recs,
+			size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		const struct bt_mesh_vendor_kv_rec_hdr hdr = {
+			.key = recs[i].key,
+			.len = recs[i].len,
+		};
+
+		(void)bt_mesh_vendor_kv_rec_hdr_encode(msg, &hdr);
+		net_buf_simple_add_mem(msg, recs[i].value, recs[i].len);
+	}
+}
+
+/* The server answers in the order the keys were asked for, and leaves out the keys that
+ * don't fit in the status.
+ */
+static int kv_recs_read(struct net_buf_simple *buf, struct bt_mesh_vendor_kv_rec *recs,
+			size_t count)
+{
+	struct bt_mesh_vendor_kv_rec_hdr hdr;
+	int ret = 0;
+	size_t i;
+
+	for (i = 0; i < count && buf->len; i++) {
+		if (bt_mesh_vendor_kv_rec_hdr_decode(buf, &hdr) || buf->len < hdr.len ||
+		    hdr.key != recs[i].key) {
+			return -EBADMSG;
+		}
+
+		if (!hdr.len) {
+			ret = ret ? ret : -ENOENT;
+		} else if (hdr.len > recs[i].len) {
+			ret = ret ? ret : -ENOBUFS;
+		} else {
+			memcpy(recs[i].value, buf->data, hdr.len);
+		}
+
+		recs[i].len = hdr.len;
+		net_buf_simple_pull(buf, hdr.len);
+	}
+
+	if (buf->len) {
+		return -EBADMSG;
+	}
+
+	return (i < count && !ret) ? -EMSGSIZE : ret;
+}
+
+static int kv_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx, uint32_t op,
+		   struct net_buf_simple *rsp, const struct bt_mesh_vendor_kv_rec *recs,
+		   size_t count)
+{
+	struct bt_mesh_vendor_status status = {
+		.buf = rsp,
+	};
+	struct sync_rsp sync = { .rsp = &status };
+	struct bt_mesh_vendor_cli_txn txn;
+	struct net_buf_simple msg;
+	uint8_t tid;
+	int err;
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	k_sem_init(&sync.sem, 0, 1);
+
+	err = txn_alloc(cli, ctx, op, sync_rsp_cb, &sync, NULL, &tid);
+	if (err) {
+		bt_mesh_vendor_pool_buf_put(&msg);
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, op);
+	net_buf_simple_add_u8(&msg, tid);
+
+	if (op == BT_MESH_VENDOR_OP_KV_GET) {
+		for (size_t i = 0; i < count; i++) {
+			net_buf_simple_add_u8(&msg, recs[i].key);
+		}
+	} else {
+		kv_recs_add(&msg, recs, count);
+	}
+
+	LOG_DBG("Sending KV %s, TID %u, %zu keys", op == BT_MESH_VENDOR_OP_KV_GET ? "GET" : "SET",
+		tid, count);
+
+	err = txn_send(cli, ctx, tid, &msg, BT_MESH_VENDOR_PRIO_NORMAL);
+	bt_mesh_vendor_pool_buf_put(&msg);
+	if (err) {
+		txn_take(cli, tid, BT_MESH_ADDR_UNASSIGNED, &txn);
+		return err;
+	}
+
+	return sync_rsp_wait(cli, ctx, &sync, tid);
+}
+#endif
+
+int bt_mesh_vendor_cli_kv_get(struct bt_mesh_vendor_cli *cli,
+			      struct bt_mesh_msg_ctx *ctx,
+			      struct bt_mesh_vendor_kv_rec *recs, size_t count)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	struct net_buf_simple rsp;
+	int err;
+
+	if (!recs || !count) {
+		return -EINVAL;
+	}
+
+	if (count > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_KV_GET);
+		return -EMSGSIZE;
+	}
+
+	err = bt_mesh_vendor_pool_buf_get(&rsp);
+	if (err) {
+		return err;
+	}
+
+	err = kv_send(cli, ctx, BT_MESH_VENDOR_OP_KV_GET, &rsp, recs, count);
+	if (!err) {
+		err = kv_recs_read(&rsp, recs, count);
+	}
+
+	bt_mesh_vendor_pool_buf_put(&rsp);
+
+	return err;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_kv_set(struct bt_mesh_vendor_cli *cli,
+			      struct bt_mesh_msg_ctx *ctx,
+			      const struct bt_mesh_vendor_kv_rec *recs, size_t count)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	struct net_buf_simple rsp;
+	int err;
+
+	if (!recs || !count) {
+		return -EINVAL;
+	}
+
+	if (kv_recs_len(recs, count) > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_KV_SET);
+		return -EMSGSIZE;
+	}
+
+	err = bt_mesh_vendor_pool_buf_get(&rsp);
+	if (err) {
+		return err;
+	}
+
+	err = kv_send(cli, ctx, BT_MESH_VENDOR_OP_KV_SET, &rsp, recs, count);
+	if (!err && rsp.len) {
+		LOG_WRN("%u keys rejected, first 0x%02x", rsp.len, rsp.data[0]);
+		err = -EPERM;
+	}
+
+	bt_mesh_vendor_pool_buf_put(&rsp);
+
+	return err;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_kv_set_unack(struct bt_mesh_vendor_cli *cli,
+				    struct bt_mesh_msg_ctx *ctx,
+				    const struct bt_mesh_vendor_kv_rec *recs, size_t count)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	struct net_buf_simple msg;
+	int err;
+
+	if (!recs || !count) {
+		return -EINVAL;
+	}
+
+	/* Without a TID, the records can take its byte */
+	if (kv_recs_len(recs, count) > BT_MESH_VENDOR_TID_LEN + BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_KV_SET_UNACK);
+		return -EMSGSIZE;
+	}
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_KV_SET_UNACK);
+	kv_recs_add(&msg, recs, count);
+
+	LOG_DBG("Sending KV SET UNACK, %zu keys", count);
+
+	/* No acknowledgment is expected, so we use direct send */
+	err = msg_send(cli, ctx, &msg, BT_MESH_VENDOR_PRIO_NORMAL, BT_MESH_VENDOR_TID_NONE);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_kv_handler_set(struct bt_mesh_vendor_cli *cli,
+				      bt_mesh_vendor_cli_kv_handler_t handler)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	cli->kv_handler = handler;
+
+	k_spin_unlock(&cli->lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+static bool batch_matches(const struct bt_mesh_vendor_cli_batch *batch,
+			  const struct bt_mesh_msg_ctx *ctx)
+{
+	if (!ctx) {
+		return batch->pub;
+	}
+
+	return !batch->pub && batch->ctx.addr == ctx->addr && batch->ctx.net_idx == ctx->net_idx &&
+	       batch->ctx.app_idx == ctx->app_idx;
+}
+
+/* Find the batch for the destination, or else a free batch, or else the oldest batch. Must be
+ * called with the client lock held.
+ */
+static struct bt_mesh_vendor_cli_batch *batch_find(struct bt_mesh_vendor_cli *cli,
+						   const struct bt_mesh_msg_ctx *ctx)
+{
+	struct bt_mesh_vendor_cli_batch *oldest = &cli->batch.slots[0];
+	struct bt_mesh_vendor_cli_batch *free = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(cli->batch.slots); i++) {
+		struct bt_mesh_vendor_cli_batch *batch = &cli->batch.slots[i];
+
+		if (!batch->count) {
+			free = free ? free : batch;
+		} else if (batch_matches(batch, ctx)) {
+			return batch;
+		} else if (batch->deadline < oldest->deadline) {
+			oldest = batch;
+		}
+	}
+
+	return free ? free : oldest;
+}
+
+/* Schedule the batch work for the earliest batch deadline */
+static void batch_timer_update(struct bt_mesh_vendor_cli *cli)
+{
+	int64_t next = INT64_MAX;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cli->batch.slots); i++) {
+		if (cli->batch.slots[i].count) {
+			next = MIN(next, cli->batch.slots[i].deadline);
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	if (next == INT64_MAX) {
+		k_work_cancel_delayable(&cli->batch.work);
+	} else {
+		k_work_reschedule(&cli->batch.work, K_MSEC(MAX(next - k_uptime_get(), 0)));
+	}
+}
+
+/* Send the records of a batch, if there are any left */
+static int batch_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_vendor_cli_batch *batch)
+{
+	struct bt_mesh_msg_ctx ctx;
+	struct net_buf_simple msg;
+	k_spinlock_key_t key;
+	uint8_t count;
+	bool pub;
+	int err;
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	key = k_spin_lock(&cli->lock);
+
+	count = batch->count;
+	if (count) {
+		bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_SET_UNACK_BATCH);
+		net_buf_simple_add_mem(&msg, batch->data, batch->len);
+		ctx = batch->ctx;
+		pub = batch->pub;
+		batch->count = 0;
+		batch->len = 0;
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	if (count) {
+		LOG_DBG("Sending SET UNACK BATCH, %u records length %u", count, msg.len);
+		err = msg_send(cli, pub ? NULL : &ctx, &msg, BT_MESH_VENDOR_PRIO_NORMAL,
+			       BT_MESH_VENDOR_TID_NONE);
+	}
+
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+
+/* Send the batch for the destination, so a record sent on its own doesn't overtake it */
+static int batch_send_to(struct bt_mesh_vendor_cli *cli, const struct bt_mesh_msg_ctx *ctx)
+{
+	struct bt_mesh_vendor_cli_batch *batch;
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+	bool pending;
+
+	batch = batch_find(cli, ctx);
+	pending = batch->count && batch_matches(batch, ctx);
 
-	LOG_DBG("Received STATUS message, data length %d", buf->len);
+	k_spin_unlock(&cli->lock, key);
+
+	return pending ? batch_send(cli, batch) : 0;
+}
+
+static void batch_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_mesh_vendor_cli *cli = CONTAINER_OF(dwork, struct bt_mesh_vendor_cli,
+						      batch.work);
+	int64_t now = k_uptime_get();
 
-	status.buf = buf;
+	for (int i = 0; i < ARRAY_SIZE(cli->batch.slots); i++) {
+		struct bt_mesh_vendor_cli_batch *batch = &cli->batch.slots[i];
+		k_spinlock_key_t key = k_spin_lock(&cli->lock);
+		bool due = batch->count && batch->deadline <= now;
 
-	if (bt_mesh_msg_ack_ctx_match(&cli->ack_ctx, BT_MESH_VENDOR_OP_STATUS, ctx->addr, (void **)&rsp)) {
-		rsp->buf = buf;
+		k_spin_unlock(&cli->lock, key);
 
-		bt_mesh_msg_ack_ctx_rx(&cli->ack_ctx);
+		if (due) {
+			(void)batch_send(cli, batch);
+		}
 	}
 
-	if (cli->status_handler) {
-		cli->status_handler(cli, ctx, &status);
+	batch_timer_update(cli);
+}
+
+static int batch_add(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		     const struct bt_mesh_vendor_set *set, size_t len)
+{
+	struct bt_mesh_vendor_cli_batch *batch;
+	struct net_buf_simple buf;
+	k_spinlock_key_t key;
+	bool first;
+	bool full;
+	int err;
+
+	while (true) {
+		key = k_spin_lock(&cli->lock);
+
+		batch = batch_find(cli, ctx);
+		if (!batch->count ||
+		    (batch_matches(batch, ctx) && batch->len + 1 + len <= sizeof(batch->data))) {
+			break;
+		}
+
+		k_spin_unlock(&cli->lock, key);
+
+		/* Make room by sending the batch for the destination, or the oldest batch */
+		err = batch_send(cli, batch);
+		if (err) {
+			return err;
+		}
+	}
+
+	first = !batch->count;
+	if (first) {
+		batch->pub = !ctx;
+		if (ctx) {
+			batch->ctx = *ctx;
+		}
+
+		batch->deadline = k_uptime_get() + CONFIG_BT_MESH_VENDOR_BATCH_TIMEOUT;
+	}
+
+	net_buf_simple_init_with_data(&buf, batch->data, sizeof(batch->data));
+	buf.len = batch->len;
+	net_buf_simple_add_u8(&buf, len);
+	set_add(&buf, set);
+	batch->len = buf.len;
+	batch->count++;
+
+	/* Send the batch once there's no room for another record */
+	full = (batch->count >= CONFIG_BT_MESH_VENDOR_BATCH_RECORDS ||
+		batch->len + 2 > sizeof(batch->data));
+
+	k_spin_unlock(&cli->lock, key);
+
+	LOG_DBG("Batched SET UNACK, data length %zu", len);
+
+	if (full) {
+		return batch_send(cli, batch);
+	}
+
+	if (first) {
+		batch_timer_update(cli);
 	}
 
 	return 0;
 }
+#endif
 
-const struct bt_mesh_model_op _bt_mesh_vendor_cli_op[] = {
-	{
-		BT_MESH_VENDOR_OP_STATUS, 0, handle_status
-	},
-	BT_MESH_MODEL_OP_END,
-};
+bool bt_mesh_vendor_cli_set_unseg(struct bt_mesh_vendor_cli *cli,
+				  struct bt_mesh_msg_ctx *ctx, size_t len)
+{
+	bool send_rel = ctx ? ctx->send_rel : cli->pub.send_rel;
+	uint16_t addr = ctx ? ctx->addr : cli->pub.addr;
+	bool compact = len <= BT_MESH_VENDOR_MSG_MAXLEN_SET_C;
+	k_spinlock_key_t key;
 
-static int vendor_cli_init(const struct bt_mesh_model *model)
+	/* The same choice bt_mesh_vendor_cli_set_async() makes */
+	if (compact) {
+		key = k_spin_lock(&cli->lock);
+		compact = !txn_compact_find(cli, addr) && !compact_held(cli, addr, k_uptime_get());
+		k_spin_unlock(&cli->lock, key);
+	}
+
+	if (compact) {
+		return bt_mesh_vendor_msg_unseg(BT_MESH_VENDOR_OP_SET_C, len, send_rel);
+	}
+
+	return bt_mesh_vendor_msg_unseg(BT_MESH_VENDOR_OP_SET, BT_MESH_VENDOR_TID_LEN + len,
+					send_rel);
+}
+
+int bt_mesh_vendor_cli_batch_enable(struct bt_mesh_vendor_cli *cli, bool enable)
 {
-	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+	cli->batch.enabled = enable;
 
-	cli->model = model;
-	cli->pub.msg = &cli->pub_msg;
-	net_buf_simple_init_with_data(&cli->pub_msg, cli->buf, sizeof(cli->buf));
-	bt_mesh_msg_ack_ctx_init(&cli->ack_ctx);
+	return enable ? 0 : bt_mesh_vendor_cli_batch_flush(cli);
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_batch_flush(struct bt_mesh_vendor_cli *cli)
+{
+	int err = 0;
+
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+	for (int i = 0; i < ARRAY_SIZE(cli->batch.slots); i++) {
+		int ret = batch_send(cli, &cli->batch.slots[i]);
+
+		err = err ? err : ret;
+	}
+
+	batch_timer_update(cli);
+#endif
+
+	return err;
+}
+
+int bt_mesh_vendor_cli_set_unack(struct bt_mesh_vendor_cli *cli,
+			   struct bt_mesh_msg_ctx *ctx,
+			   const struct bt_mesh_vendor_set *set)
+{
+	size_t len = set_len(set);
+	struct net_buf_simple msg;
+	int err;
+
+	if (len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_SET_UNACK);
+		return -EMSGSIZE;
+	}
+
+#if defined(CONFIG_BT_MESH_VENDOR_BATCH)
+	/* Urgent payloads don't wait in a batch */
+	if (cli->batch.enabled && set->prio != BT_MESH_VENDOR_PRIO_URGENT) {
+		if (len <= BT_MESH_VENDOR_BATCH_RECORD_MAXLEN &&
+		    len + 1 <= CONFIG_BT_MESH_VENDOR_BATCH_SIZE) {
+			return batch_add(cli, ctx, set, len);
+		}
+
+		err = batch_send_to(cli, ctx);
+		if (err) {
+			return err;
+		}
+	}
+#endif
+
+	LOG_DBG("Sending SET UNACK message, data length %zu", len);
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	set_build(cli, ctx, &msg, set, false, BT_MESH_VENDOR_TID_NONE);
+
+	/* No acknowledgment is expected, so we use direct send */
+	err = msg_send(cli, ctx, &msg, set->prio, BT_MESH_VENDOR_TID_NONE);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+/* Drop the oldest record from the ring. Must be called with the client lock held. */
+static void stream_evict(struct bt_mesh_vendor_cli *cli)
+{
+	uint16_t seq = cli->stream.seq - cli->stream.count;
+	uint8_t slot = seq % BT_MESH_VENDOR_STREAM_WINDOW;
+
+	cli->stream.used -= cli->stream.recs[slot].len;
+	cli->stream.repair &= ~BIT(slot);
+	cli->stream.count--;
+}
+
+/* The ring wraps around, so a record may be split in two */
+static void stream_ring_write(struct bt_mesh_vendor_cli *cli, uint16_t off,
+			      const uint8_t *data, uint16_t len)
+{
+	uint16_t first = MIN(len, sizeof(cli->stream.ring) - off);
+
+	memcpy(&cli->stream.ring[off], data, first);
+	memcpy(cli->stream.ring, &data[first], len - first);
+}
+
+static void stream_ring_read(struct bt_mesh_vendor_cli *cli, uint16_t off, uint16_t len,
+			     struct net_buf_simple *msg)
+{
+	uint16_t first = MIN(len, sizeof(cli->stream.ring) - off);
+
+	net_buf_simple_add_mem(msg, &cli->stream.ring[off], first);
+	net_buf_simple_add_mem(msg, cli->stream.ring, len - first);
+}
+
+/* Send the records the server asked for again, oldest first */
+static void stream_repair(struct k_work *work)
+{
+	struct bt_mesh_vendor_cli *cli = CONTAINER_OF(work, struct bt_mesh_vendor_cli,
+						      stream.repair_work);
+
+	while (true) {
+		struct bt_mesh_vendor_stream_hdr hdr;
+		enum bt_mesh_vendor_prio prio;
+		struct bt_mesh_msg_ctx ctx;
+		struct net_buf_simple msg;
+		k_spinlock_key_t key;
+		bool found = false;
+		bool pub;
+		int err;
+
+		err = bt_mesh_vendor_pool_buf_get(&msg);
+		if (err) {
+			/* The server asks again if the records are still missing */
+			LOG_WRN("No buffer to send stream records again");
+			return;
+		}
+
+		key = k_spin_lock(&cli->lock);
+
+		for (uint8_t i = 0; cli->stream.active && i < cli->stream.count; i++) {
+			uint16_t seq = cli->stream.seq - cli->stream.count + i;
+			uint8_t slot = seq % BT_MESH_VENDOR_STREAM_WINDOW;
+
+			if (cli->stream.repair & BIT(slot)) {
+				cli->stream.repair &= ~BIT(slot);
+				hdr.id = cli->stream.id;
+				hdr.seq = seq;
+				bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_STREAM);
+				(void)bt_mesh_vendor_stream_hdr_encode(&msg, &hdr);
+				stream_ring_read(cli, cli->stream.recs[slot].off,
+						 cli->stream.recs[slot].len, &msg);
+				prio = cli->stream.recs[slot].prio;
+				ctx = cli->stream.ctx;
+				pub = cli->stream.pub;
+				found = true;
+				break;
+			}
+		}
+
+		k_spin_unlock(&cli->lock, key);
+
+		if (found) {
+			LOG_DBG("Sending STREAM record %u again", hdr.seq);
+			err = msg_send(cli, pub ? NULL : &ctx, &msg, prio, BT_MESH_VENDOR_TID_NONE);
+			if (err) {
+				LOG_WRN("Failed to send stream record %u again (err: %d)", hdr.seq,
+					err);
+			}
+		}
+
+		bt_mesh_vendor_pool_buf_put(&msg);
+
+		if (!found) {
+			return;
+		}
+	}
+}
+#endif
+
+int bt_mesh_vendor_cli_stream_start(struct bt_mesh_vendor_cli *cli,
+				    struct bt_mesh_msg_ctx *ctx)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	cli->stream.pub = !ctx;
+	if (ctx) {
+		cli->stream.ctx = *ctx;
+	}
+
+	/* The server starts over when the stream ID changes */
+	cli->stream.id++;
+	cli->stream.seq = 0;
+	cli->stream.count = 0;
+	cli->stream.head = 0;
+	cli->stream.used = 0;
+	cli->stream.repair = 0;
+	cli->stream.active = true;
+
+	k_spin_unlock(&cli->lock, key);
 
 	return 0;
+#else
+	return -ENOTSUP;
+#endif
 }
 
-static void vendor_cli_reset(const struct bt_mesh_model *model)
+int bt_mesh_vendor_cli_stream_send(struct bt_mesh_vendor_cli *cli,
+				   const struct bt_mesh_vendor_set *set)
 {
-	struct bt_mesh_vendor_cli *cli = model->rt->user_data;
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	struct bt_mesh_vendor_cli_stream_rec *rec;
+	struct bt_mesh_vendor_stream_hdr hdr;
+	size_t len = set_len(set);
+	struct bt_mesh_msg_ctx ctx;
+	struct net_buf_simple msg;
+	k_spinlock_key_t key;
+	bool pub;
+	int err;
 
-	net_buf_simple_reset(cli->pub.msg);
-	bt_mesh_msg_ack_ctx_reset(&cli->ack_ctx);
+	if (len > BT_MESH_VENDOR_STREAM_DATA_MAXLEN || len > sizeof(cli->stream.ring)) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_STREAM);
+		return -EMSGSIZE;
+	}
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	key = k_spin_lock(&cli->lock);
+
+	if (!cli->stream.active) {
+		k_spin_unlock(&cli->lock, key);
+		bt_mesh_vendor_pool_buf_put(&msg);
+		return -ENOTCONN;
+	}
+
+	while (cli->stream.count == BT_MESH_VENDOR_STREAM_WINDOW ||
+	       cli->stream.used + len > sizeof(cli->stream.ring)) {
+		stream_evict(cli);
+	}
+
+	hdr.id = cli->stream.id;
+	hdr.seq = cli->stream.seq++;
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_STREAM);
+	(void)bt_mesh_vendor_stream_hdr_encode(&msg, &hdr);
+	set_add(&msg, set);
+
+	/* Keep a copy of the record, in case the server misses it */
+	rec = &cli->stream.recs[hdr.seq % BT_MESH_VENDOR_STREAM_WINDOW];
+	rec->off = cli->stream.head;
+	rec->len = len;
+	rec->prio = set->prio;
+	stream_ring_write(cli, rec->off, &msg.data[msg.len - len], len);
+	cli->stream.head = (cli->stream.head + len) % sizeof(cli->stream.ring);
+	cli->stream.used += len;
+	cli->stream.count++;
+
+	ctx = cli->stream.ctx;
+	pub = cli->stream.pub;
+
+	k_spin_unlock(&cli->lock, key);
+
+	LOG_DBG("Sending STREAM record %u, data length %zu", hdr.seq, len);
+
+	err = msg_send(cli, pub ? NULL : &ctx, &msg, set->prio, BT_MESH_VENDOR_TID_NONE);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+#else
+	return -ENOTSUP;
+#endif
 }
 
-const struct bt_mesh_model_cb _bt_mesh_vendor_cli_cb = {
-	.init = vendor_cli_init,
-	.reset = vendor_cli_reset,
+int bt_mesh_vendor_cli_stream_stop(struct bt_mesh_vendor_cli *cli)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	cli->stream.active = false;
+	cli->stream.count = 0;
+	cli->stream.used = 0;
+	cli->stream.repair = 0;
+
+	k_spin_unlock(&cli->lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_rtt_get(struct bt_mesh_vendor_cli *cli,
+			       struct bt_mesh_vendor_cli_rtt *entries, size_t max)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT)
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+	size_t count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(cli->rtt) && count < max; i++) {
+		if (cli->rtt[i].addr != BT_MESH_ADDR_UNASSIGNED) {
+			entries[count++] = cli->rtt[i];
+		}
+	}
+
+	k_spin_unlock(&cli->lock, key);
+
+	return count;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_pace_ready_set(struct bt_mesh_vendor_cli *cli,
+				      void (*ready)(struct bt_mesh_vendor_cli *cli))
+{
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	cli->pace.ready = ready;
+
+	k_spin_unlock(&cli->lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_pace_get(struct bt_mesh_vendor_cli *cli,
+				struct bt_mesh_vendor_cli_pace_status *status)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_PACE)
+	k_spinlock_key_t key = k_spin_lock(&cli->lock);
+
+	status->rate = cli->pace.rate;
+	status->srtt = cli->pace.srtt;
+	status->queued = cli->pace.count;
+	memcpy(status->classes, cli->pace.classes, sizeof(status->classes));
+
+	k_spin_unlock(&cli->lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+/* Sender side of a bulk transfer. Bit n of the bitmaps refers to chunk base + n. */
+struct bulk_tx {
+	const uint8_t *data;
+	size_t len;
+	uint16_t count;
+	/** First chunk not acknowledged by the server */
+	uint16_t base;
+	/** First chunk never sent */
+	uint16_t next;
+	/** Chunks acknowledged by the server */
+	uint32_t acked;
+	/** Missing chunks already sent again since the last timeout */
+	uint32_t resent;
 };
 
-int bt_mesh_vendor_cli_set(struct bt_mesh_vendor_cli *cli,
-			   struct bt_mesh_msg_ctx *ctx,
-			   const struct bt_mesh_vendor_set *set,
-			   struct bt_mesh_vendor_status *rsp)
+#define BULK_ACK_INTERVAL MAX(CONFIG_BT_MESH_VENDOR_BULK_WINDOW / 2, 1)
+
+static void bulk_tx_end(int err, void *cb_data)
 {
-	if (set && set->buf && set->buf->len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
-		return -EMSGSIZE;
+	struct bt_mesh_vendor_cli *cli = cb_data;
+
+	k_sem_give(&cli->bulk.tx_sem);
+}
+
+static const struct bt_mesh_send_cb bulk_tx_cb = {
+	.end = bulk_tx_end,
+};
+
+static int bulk_msg_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			 struct net_buf_simple *msg, struct bt_mesh_vendor_bulk_ack *ack)
+{
+	int err;
+
+	/* The transport layer only accepts one segmented message per destination at a time,
+	 * so wait for the previous message to leave it. This does not wait for the server.
+	 */
+	err = k_sem_take(&cli->bulk.tx_sem, K_MSEC(model_ackd_timeout_get(cli->model, ctx)));
+	if (err) {
+		return -ETIMEDOUT;
+	}
+
+	/* Already prepared if a previous acknowledgment request is still outstanding */
+	if (ack && !bt_mesh_msg_ack_ctx_busy(&cli->bulk.ack_ctx)) {
+		bt_mesh_msg_ack_ctx_prepare(&cli->bulk.ack_ctx, BT_MESH_VENDOR_OP_BULK_ACK,
+					    ctx->addr, ack);
+	}
+
+	_bt_mesh_vendor_stats_tx(msg);
+	err = bt_mesh_model_send(cli->model, ctx, msg, &bulk_tx_cb, cli);
+	if (err) {
+		k_sem_give(&cli->bulk.tx_sem);
 	}
 
-	LOG_DBG("Sending SET message, data length %d", set->buf->len);
+	return err;
+}
 
-	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_SET, set->buf->len);
-	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_SET);
+static int bulk_chunk_send(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			   const struct bulk_tx *tx, uint16_t idx, struct bt_mesh_vendor_bulk_ack *ack)
+{
+	size_t offset = (size_t)idx * CONFIG_BT_MESH_VENDOR_BULK_CHUNK_SIZE;
+	size_t len = MIN(tx->len - offset, CONFIG_BT_MESH_VENDOR_BULK_CHUNK_SIZE);
+	struct net_buf_simple msg;
+	int err;
 
-	if (set->buf->len > 0) {
-		net_buf_simple_add_mem(&msg, set->buf->data, set->buf->len);
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
 	}
 
-	struct bt_mesh_msg_rsp_ctx rsp_ctx = {
-		.ack = &cli->ack_ctx,
-		.op = BT_MESH_VENDOR_OP_STATUS,
-		.user_data = rsp,
-		.timeout = model_ackd_timeout_get(cli->model, ctx),
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_BULK_CHUNK);
+	net_buf_simple_add_u8(&msg, cli->bulk.id);
+	net_buf_simple_add_le16(&msg, idx | (ack ? BT_MESH_VENDOR_BULK_ACK_REQ : 0));
+	net_buf_simple_add_mem(&msg, &tx->data[offset], len);
+
+	err = bulk_msg_send(cli, ctx, &msg, ack);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+
+static int bulk_start(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		      const struct bulk_tx *tx, struct bt_mesh_vendor_bulk_ack *ack)
+{
+	int32_t timeout = model_ackd_timeout_get(cli->model, ctx);
+	const struct bt_mesh_vendor_bulk_start start = {
+		.id = cli->bulk.id,
+		.len = tx->len,
+		.chunk_size = CONFIG_BT_MESH_VENDOR_BULK_CHUNK_SIZE,
+		.crc = crc32_ieee(tx->data, tx->len),
 	};
+	int err;
+
+	for (int i = 0; i <= CONFIG_BT_MESH_VENDOR_BULK_RETRIES; i++) {
+		/* The message is encrypted in place when sent, so build it for every attempt */
+		BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_BULK_START,
+					 BT_MESH_VENDOR_MSG_LEN_BULK_START);
+		bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_BULK_START);
+		(void)bt_mesh_vendor_bulk_start_encode(&msg, &start);
+
+		err = bulk_msg_send(cli, ctx, &msg, ack);
+		if (err) {
+			bt_mesh_msg_ack_ctx_clear(&cli->bulk.ack_ctx);
+			return err;
+		}
+
+		err = bt_mesh_msg_ack_ctx_wait(&cli->bulk.ack_ctx, K_MSEC(timeout));
+		if (err != -ETIMEDOUT) {
+			break;
+		}
+	}
+
+	if (err) {
+		return err;
+	}
 
-	return bt_mesh_msg_ackd_send(cli->model, ctx, &msg, rsp ? &rsp_ctx : NULL);
+	return ack->status == BT_MESH_VENDOR_BULK_IN_PROGRESS ? 0 : -ECONNREFUSED;
 }
 
-int bt_mesh_vendor_cli_get(struct bt_mesh_vendor_cli *cli,
-			   struct bt_mesh_msg_ctx *ctx,
-			   const struct bt_mesh_vendor_get *get,
-			   struct bt_mesh_vendor_status *rsp)
+/* Send the chunks the server is missing below the highest chunk it has seen, followed by
+ * new chunks up to the edge of the window. An acknowledgment is requested every half
+ * window and on the last chunk of the pass.
+ */
+static int bulk_pass(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+		     struct bulk_tx *tx, struct bt_mesh_vendor_bulk_ack *ack)
 {
-	/* Define buffer with enough space for the length parameter if present */
-	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_GET, BT_MESH_VENDOR_MSG_MAXLEN_GET);
-	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_GET);
+	uint16_t end = MIN(tx->base + CONFIG_BT_MESH_VENDOR_BULK_WINDOW, tx->count);
+	uint32_t below_top = tx->acked ? BIT(find_msb_set(tx->acked) - 1) - 1 : 0;
+	uint32_t holes = ~(tx->acked | tx->resent) & below_top;
+	int last = -1;
+	int err;
 
-	/* Add optional length parameter if present */
-	if (get) {
-		LOG_DBG("Sending GET message with length parameter: %u", get->length);
-		net_buf_simple_add_le16(&msg, get->length);
-	} else {
-		LOG_DBG("Sending GET message without length parameter");
+	if (tx->next < end) {
+		last = end - 1;
+	} else if (holes) {
+		last = tx->base + find_msb_set(holes) - 1;
 	}
 
-	struct bt_mesh_msg_rsp_ctx rsp_ctx = {
-		.ack = &cli->ack_ctx,
-		.op = BT_MESH_VENDOR_OP_STATUS,
-		.user_data = rsp,
-		.timeout = model_ackd_timeout_get(cli->model, ctx),
-	};
+	for (uint16_t i = 0; holes; i++, holes >>= 1) {
+		if (!(holes & BIT(0))) {
+			continue;
+		}
+
+		tx->resent |= BIT(i);
+		err = bulk_chunk_send(cli, ctx, tx, tx->base + i,
+				      tx->base + i == last ? ack : NULL);
+		if (err) {
+			return err;
+		}
+	}
 
-	return bt_mesh_msg_ackd_send(cli->model, ctx, &msg, rsp ? &rsp_ctx : NULL);
+	for (; tx->next < end; tx->next++) {
+		bool ack_req = (tx->next == last || (tx->next + 1) % BULK_ACK_INTERVAL == 0);
+
+		err = bulk_chunk_send(cli, ctx, tx, tx->next, ack_req ? ack : NULL);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
 }
 
-int bt_mesh_vendor_cli_set_unack(struct bt_mesh_vendor_cli *cli,
-			   struct bt_mesh_msg_ctx *ctx,
-			   const struct bt_mesh_vendor_set *set)
+int bt_mesh_vendor_cli_bulk_send(struct bt_mesh_vendor_cli *cli,
+				 struct bt_mesh_msg_ctx *ctx,
+				 const uint8_t *data, size_t len)
 {
-	if (set && set->buf && set->buf->len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+	int32_t timeout = model_ackd_timeout_get(cli->model, ctx);
+	struct bulk_tx tx = {
+		.data = data,
+		.len = len,
+		.count = DIV_ROUND_UP(len, CONFIG_BT_MESH_VENDOR_BULK_CHUNK_SIZE),
+	};
+	struct bt_mesh_vendor_bulk_ack ack;
+	int retries = 0;
+	int err;
+
+	if (!ctx || !BT_MESH_ADDR_IS_UNICAST(ctx->addr) || !data || !len) {
+		return -EINVAL;
+	}
+
+	if (len > (size_t)BT_MESH_VENDOR_BULK_CHUNK_COUNT_MAX *
+		  CONFIG_BT_MESH_VENDOR_BULK_CHUNK_SIZE) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_BULK_START);
 		return -EMSGSIZE;
 	}
 
-	LOG_DBG("Sending SET UNACK message, data length %d", set->buf->len);
+	cli->bulk.id++;
 
-	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_SET_UNACK, set->buf->len);
-	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_SET_UNACK);
+	LOG_DBG("Starting BULK transfer %u, data length %zu in %u chunks", cli->bulk.id, len,
+		tx.count);
 
-	if (set->buf->len > 0) {
-		net_buf_simple_add_mem(&msg, set->buf->data, set->buf->len);
+	err = bulk_start(cli, ctx, &tx, &ack);
+	if (err) {
+		return err;
 	}
 
-	/* No acknowledgment is expected, so we use direct send */
-	return bt_mesh_msg_send(cli->model, ctx, &msg);
+	while (true) {
+		err = bulk_pass(cli, ctx, &tx, &ack);
+		if (err) {
+			break;
+		}
+
+		/* Make sure a late acknowledgment is still picked up if the pass sent nothing */
+		if (!bt_mesh_msg_ack_ctx_busy(&cli->bulk.ack_ctx)) {
+			bt_mesh_msg_ack_ctx_prepare(&cli->bulk.ack_ctx,
+						    BT_MESH_VENDOR_OP_BULK_ACK, ctx->addr, &ack);
+		}
+
+		err = bt_mesh_msg_ack_ctx_wait(&cli->bulk.ack_ctx, K_MSEC(timeout));
+		if (err == -ETIMEDOUT) {
+			if (++retries > CONFIG_BT_MESH_VENDOR_BULK_RETRIES) {
+				break;
+			}
+
+			/* Probe with the oldest unacknowledged chunk, and allow every hole
+			 * the answer reveals to be sent again.
+			 */
+			LOG_DBG("BULK ACK timeout, probing chunk %u", tx.base);
+			tx.resent = 0;
+			err = bulk_chunk_send(cli, ctx, &tx, tx.base, &ack);
+			if (err) {
+				break;
+			}
+
+			continue;
+		} else if (err) {
+			break;
+		}
+
+		retries = 0;
+
+		if (ack.status == BT_MESH_VENDOR_BULK_COMPLETE) {
+			break;
+		} else if (ack.status == BT_MESH_VENDOR_BULK_CRC_ERROR) {
+			err = -EBADMSG;
+			break;
+		} else if (ack.status != BT_MESH_VENDOR_BULK_IN_PROGRESS) {
+			err = -ECONNREFUSED;
+			break;
+		}
+
+		/* Acknowledgments may arrive out of order, only move forward */
+		if (ack.base >= tx.base && ack.base <= tx.next) {
+			uint16_t shift = ack.base - tx.base;
+
+			tx.resent = shift < 32 ? tx.resent >> shift : 0;
+			tx.acked = ack.bitmap;
+			tx.base = ack.base;
+		}
+	}
+
+	bt_mesh_msg_ack_ctx_clear(&cli->bulk.ack_ctx);
+
+	LOG_DBG("BULK transfer %u finished (err: %d)", cli->bulk.id, err);
+
+	return err;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+static int stats_get(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx, uint8_t kind,
+		     uint8_t arg, uint32_t *values, size_t count)
+{
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_STATS_GET,
+				 BT_MESH_VENDOR_MSG_LEN_STATS_GET);
+	struct stats_rsp rsp = {
+		.kind = kind,
+		.arg = arg,
+		.values = values,
+		.count = count,
+	};
+	int err;
+
+	if (!ctx || !BT_MESH_ADDR_IS_UNICAST(ctx->addr)) {
+		return -EINVAL;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_STATS_GET);
+	net_buf_simple_add_u8(&msg, kind);
+	net_buf_simple_add_u8(&msg, arg);
+
+	err = bt_mesh_msg_ack_ctx_prepare(&cli->stats_ack, BT_MESH_VENDOR_OP_STATS_STATUS,
+					  ctx->addr, &rsp);
+	if (err) {
+		return -EBUSY;
+	}
+
+	LOG_DBG("Sending STATS GET %u/0x%02x", kind, arg);
+
+	err = msg_send(cli, ctx, &msg, BT_MESH_VENDOR_PRIO_NORMAL, BT_MESH_VENDOR_TID_NONE);
+	if (err) {
+		bt_mesh_msg_ack_ctx_clear(&cli->stats_ack);
+		return err;
+	}
+
+	err = bt_mesh_msg_ack_ctx_wait(&cli->stats_ack,
+				       K_MSEC(model_ackd_timeout_get(cli->model, ctx)));
+	if (err) {
+		_bt_mesh_vendor_stats_timeout(BT_MESH_VENDOR_OP_STATS_GET);
+		return err;
+	}
+
+	return rsp.err;
+}
+#endif
+
+int bt_mesh_vendor_cli_stats_hist_get(struct bt_mesh_vendor_cli *cli,
+				      struct bt_mesh_msg_ctx *ctx,
+				      enum bt_mesh_vendor_stats_hist hist,
+				      uint32_t buckets[BT_MESH_VENDOR_STATS_BUCKETS])
+{
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	return stats_get(cli, ctx, BT_MESH_VENDOR_STATS_KIND_HIST, hist, buckets,
+			 BT_MESH_VENDOR_STATS_BUCKETS);
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_stats_op_get(struct bt_mesh_vendor_cli *cli,
+				    struct bt_mesh_msg_ctx *ctx, uint32_t op,
+				    struct bt_mesh_vendor_stats_op *counters)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	uint32_t values[BT_MESH_VENDOR_STATS_OP_FIELDS];
+	int idx = bt_mesh_vendor_stats_op_idx(op);
+	int err;
+
+	if (idx < 0) {
+		return -ENOENT;
+	}
+
+	err = stats_get(cli, ctx, BT_MESH_VENDOR_STATS_KIND_OP,
+			BT_MESH_VENDOR_STATS_OP_FIRST + idx, values, ARRAY_SIZE(values));
+	if (err) {
+		return err;
+	}
+
+	/* The counters are sent in the order of the struct fields */
+	counters->tx = values[0];
+	counters->rx = values[1];
+	counters->tx_bytes = values[2];
+	counters->rx_bytes = values[3];
+	counters->timeouts = values[4];
+	counters->rejected = values[5];
+	counters->deferred = values[6];
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int bt_mesh_vendor_cli_stats_cmd_get(struct bt_mesh_vendor_cli *cli,
+				     struct bt_mesh_msg_ctx *ctx, uint8_t cmd,
+				     struct bt_mesh_vendor_stats_cmd *counters)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	uint32_t values[BT_MESH_VENDOR_STATS_CMD_FIELDS];
+	int err;
+
+	err = stats_get(cli, ctx, BT_MESH_VENDOR_STATS_KIND_CMD, cmd, values, ARRAY_SIZE(values));
+	if (err) {
+		return err;
+	}
+
+	counters->calls = values[0];
+	counters->rejected = values[1];
+	counters->failed = values[2];
+	counters->time_us = values[3];
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
 }
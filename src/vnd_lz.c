@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/util.h>
+#include "vnd_lz.h"
+
+/* The compressed stream is a sequence of groups of up to eight tokens, each group led by a
+ * flag byte. Bit n of the flag byte is set if token n is a match, and clear if it's a
+ * literal. A literal is one byte. A match is two bytes, holding a 12 bit distance minus one
+ * and a 4 bit length minus MATCH_MIN:
+ *
+ *   byte 0: distance[7:0]
+ *   byte 1: distance[11:8] << 4 | length
+ *
+ * Matches may reach back past the start of the payload into the static dictionary.
+ */
+#define MATCH_MIN 3
+#define MATCH_MAX (MATCH_MIN + 15)
+#define DIST_MAX  4096
+
+/* Content common in vendor payloads. Changing it breaks compatibility with other nodes. */
+static const uint8_t dict[] = "Hello World- Response OK- 0123456789ABCDEF";
+#define DICT_LEN (sizeof(dict) - 1)
+
+static inline uint8_t window_at(const uint8_t *data, int pos)
+{
+	return pos < 0 ? dict[DICT_LEN + pos] : data[pos];
+}
+
+int vnd_lz_compress(const uint8_t *in, size_t len, uint8_t *out, size_t max)
+{
+	size_t flags = 0;
+	size_t o = 0;
+	int bit = 8;
+
+	for (size_t i = 0; i < len; bit++) {
+		size_t limit = MIN(MATCH_MAX, len - i);
+		size_t best_len = 0;
+		size_t best_dist = 0;
+
+		if (bit == 8) {
+			if (o >= max) {
+				return -ENOSPC;
+			}
+
+			flags = o++;
+			out[flags] = 0;
+			bit = 0;
+		}
+
+		/* Greedy search for the longest match. The match may overlap the bytes being
+		 * encoded, the decoder produces them one at a time.
+		 */
+		for (int start = (int)i - 1;
+		     start >= -(int)DICT_LEN && i - start <= DIST_MAX && limit >= MATCH_MIN;
+		     start--) {
+			size_t l = 0;
+
+			while (l < limit && window_at(in, start + l) == in[i + l]) {
+				l++;
+			}
+
+			if (l > best_len) {
+				best_len = l;
+				best_dist = i - start;
+
+				if (l == limit) {
+					break;
+				}
+			}
+		}
+
+		if (best_len >= MATCH_MIN) {
+			if (o + 2 > max) {
+				return -ENOSPC;
+			}
+
+			out[flags] |= BIT(bit);
+			out[o++] = (best_dist - 1) & 0xff;
+			out[o++] = (((best_dist - 1) >> 8) << 4) | (best_len - MATCH_MIN);
+			i += best_len;
+		} else {
+			if (o + 1 > max) {
+				return -ENOSPC;
+			}
+
+			out[o++] = in[i++];
+		}
+	}
+
+	return o;
+}
+
+int vnd_lz_decompress(const uint8_t *in, size_t len, uint8_t *out, size_t max)
+{
+	size_t i = 0;
+	size_t o = 0;
+
+	while (i < len) {
+		uint8_t flags = in[i++];
+		int bit;
+
+		for (bit = 0; bit < 8 && i < len; bit++) {
+			if (!(flags & BIT(bit))) {
+				if (o >= max) {
+					return -EINVAL;
+				}
+
+				out[o++] = in[i++];
+				continue;
+			}
+
+			if (i + 2 > len) {
+				return -EINVAL;
+			}
+
+			size_t dist = (in[i] | ((in[i + 1] >> 4) << 8)) + 1;
+			size_t match_len = (in[i + 1] & 0x0f) + MATCH_MIN;
+
+			i += 2;
+
+			if (dist > o + DICT_LEN || o + match_len > max) {
+				return -EINVAL;
+			}
+
+			for (size_t k = 0; k < match_len; k++, o++) {
+				out[o] = window_at(out, (int)o - (int)dist);
+			}
+		}
+
+		/* The last group may be short, but not end on a token flagged as a match */
+		if (bit < 8 && (flags >> bit)) {
+			return -EINVAL;
+		}
+	}
+
+	return o;
+}
+
+int vnd_lz_compress_add(struct net_buf_simple *msg, const uint8_t *data, size_t len)
+{
+	size_t room = net_buf_simple_tailroom(msg);
+	int n;
+
+	if (len < 2 || room <= BT_MESH_MIC_SHORT) {
+		return -ENOSPC;
+	}
+
+	n = vnd_lz_compress(data, len, net_buf_simple_tail(msg),
+			    MIN(len - 1, room - BT_MESH_MIC_SHORT));
+	if (n < 0) {
+		return n;
+	}
+
+	net_buf_simple_add(msg, n);
+
+	return 0;
+}
+
+int vnd_lz_decompress_add(struct net_buf_simple *out, const struct net_buf_simple *in)
+{
+	int n = vnd_lz_decompress(in->data, in->len, net_buf_simple_tail(out),
+				  net_buf_simple_tailroom(out));
+
+	if (n < 0) {
+		return n;
+	}
+
+	net_buf_simple_add(out, n);
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef VND_LZ_H__
+#define VND_LZ_H__
+
+#include <zephyr/bluetooth/mesh.h>
+
+/**
+ * @brief Compress a vendor payload
+ *
+ * LZSS with a static dictionary shared by all vendor model nodes, so that
+ * even short payloads can reference common content.
+ *
+ * @param in  Payload to compress
+ * @param len Length of the payload
+ * @param out Output buffer
+ * @param max Size of the output buffer
+ * @return Length of the compressed payload, or -ENOSPC if it doesn't fit in @p max bytes
+ */
+int vnd_lz_compress(const uint8_t *in, size_t len, uint8_t *out, size_t max);
+
+/**
+ * @brief Decompress a vendor payload
+ *
+ * @param in  Compressed payload
+ * @param len Length of the compressed payload
+ * @param out Output buffer
+ * @param max Size of the output buffer
+ * @return Length of the decompressed payload, or -EINVAL if the input is malformed
+ *         or doesn't fit in @p max bytes
+ */
+int vnd_lz_decompress(const uint8_t *in, size_t len, uint8_t *out, size_t max);
+
+/**
+ * @brief Add a compressed payload to a message
+ *
+ * The payload is only added if it compresses to fewer bytes than it has, and
+ * fits in the message along with the TransMIC.
+ *
+ * @param msg  Message to add the payload to
+ * @param data Payload to compress
+ * @param len  Length of the payload
+ * @return 0 on success, or -ENOSPC if compression doesn't help
+ */
+int vnd_lz_compress_add(struct net_buf_simple *msg, const uint8_t *data, size_t len);
+
+/**
+ * @brief Decompress a received payload
+ *
+ * @param out Buffer to add the decompressed payload to
+ * @param in  Compressed payload
+ * @return 0 on success, or -EINVAL if the payload is malformed or doesn't fit
+ */
+int vnd_lz_decompress_add(struct net_buf_simple *out, const struct net_buf_simple *in);
+
+#endif /* VND_LZ_H__ */
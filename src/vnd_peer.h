@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef VND_PEER_H__
+#define VND_PEER_H__
+
+#include <string.h>
+#include "../include/vnd_common.h"
+
+/* Capabilities announced by this node */
+#define VND_CAPS_LOCAL (IS_ENABLED(CONFIG_BT_MESH_VENDOR_LZ) ? BT_MESH_VENDOR_CAP_LZ : 0)
+
+/* The peer tables are kept in most recently used order, so the last entry is the one to
+ * forget when a new peer shows up.
+ */
+static inline int vnd_peer_find(const struct bt_mesh_vendor_peer *peers, size_t count,
+				uint16_t addr)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (peers[i].addr == addr && addr != BT_MESH_ADDR_UNASSIGNED) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Returns the capabilities of the peer, or -ENOENT if they're unknown */
+static inline int vnd_peer_caps_get(const struct bt_mesh_vendor_peer *peers, size_t count,
+				    uint16_t addr)
+{
+	int i = vnd_peer_find(peers, count, addr);
+
+	return i < 0 ? i : peers[i].caps;
+}
+
+static inline void vnd_peer_caps_set(struct bt_mesh_vendor_peer *peers, size_t count,
+				     uint16_t addr, uint8_t caps)
+{
+	int i = vnd_peer_find(peers, count, addr);
+
+	if (i < 0) {
+		i = count - 1;
+	}
+
+	memmove(&peers[1], &peers[0], i * sizeof(peers[0]));
+	peers[0].addr = addr;
+	peers[0].caps = caps;
+	peers[0].pending = false;
+}
+
+/* Whether the peer should be asked for its capabilities, because they're unknown or the last
+ * request went unanswered for CONFIG_BT_MESH_VENDOR_CAPS_TIMEOUT. Records the request if so.
+ */
+static inline bool vnd_peer_caps_ask(struct bt_mesh_vendor_peer *peers, size_t count,
+				     uint16_t addr, int64_t now)
+{
+	int i = vnd_peer_find(peers, count, addr);
+
+	if (i < 0) {
+		vnd_peer_caps_set(peers, count, addr, 0);
+		i = 0;
+	} else if (!peers[i].pending ||
+		   now - peers[i].asked < CONFIG_BT_MESH_VENDOR_CAPS_TIMEOUT) {
+		return false;
+	}
+
+	peers[i].pending = true;
+	peers[i].asked = now;
+
+	return true;
+}
+
+#endif /* VND_PEER_H__ */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/kernel.h>
+#include "../include/vnd_pool.h"
+
+LOG_MODULE_REGISTER(vnd_pool, CONFIG_BT_MESH_MODEL_LOG_LEVEL);
+
+K_MEM_SLAB_DEFINE_STATIC(vnd_pool_slab, ROUND_UP(BT_MESH_VENDOR_POOL_BUF_SIZE, 4),
+			 CONFIG_BT_MESH_VENDOR_POOL_BUF_COUNT, 4);
+
+/* Threads that have used the pool, for the stack report */
+#define THREAD_COUNT 4
+
+static struct k_spinlock lock;
+static uint32_t max_used;
+static uint32_t failed;
+static k_tid_t threads[THREAD_COUNT];
+
+/* Must be called with the lock held */
+static void thread_track(void)
+{
+	k_tid_t self = k_current_get();
+
+	for (int i = 0; i < ARRAY_SIZE(threads); i++) {
+		if (threads[i] == self) {
+			return;
+		}
+
+		if (!threads[i]) {
+			threads[i] = self;
+			return;
+		}
+	}
+}
+
+int bt_mesh_vendor_pool_buf_get(struct net_buf_simple *buf)
+{
+	k_spinlock_key_t key;
+	void *mem;
+	int err;
+
+	err = k_mem_slab_alloc(&vnd_pool_slab, &mem, K_NO_WAIT);
+
+	key = k_spin_lock(&lock);
+
+	if (err) {
+		failed++;
+	} else {
+		max_used = MAX(max_used, k_mem_slab_num_used_get(&vnd_pool_slab));
+	}
+
+	if (IS_ENABLED(CONFIG_BT_MESH_VENDOR_MEM_REPORT)) {
+		thread_track();
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (err) {
+		LOG_WRN("Vendor buffer pool empty");
+		return -ENOMEM;
+	}
+
+	net_buf_simple_init_with_data(buf, mem, BT_MESH_VENDOR_POOL_BUF_SIZE);
+	net_buf_simple_reset(buf);
+
+	return 0;
+}
+
+void bt_mesh_vendor_pool_buf_put(struct net_buf_simple *buf)
+{
+	k_mem_slab_free(&vnd_pool_slab, buf->__buf);
+}
+
+void bt_mesh_vendor_pool_stats_get(struct bt_mesh_vendor_pool_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats->used = k_mem_slab_num_used_get(&vnd_pool_slab);
+	stats->max_used = max_used;
+	stats->total = CONFIG_BT_MESH_VENDOR_POOL_BUF_COUNT;
+	stats->failed = failed;
+
+	k_spin_unlock(&lock, key);
+}
+
+void bt_mesh_vendor_mem_report(void)
+{
+	struct bt_mesh_vendor_pool_stats stats;
+
+	bt_mesh_vendor_pool_stats_get(&stats);
+
+	LOG_INF("Vendor buffer pool: %u of %u in use, high-water %u, %u failed allocations",
+		stats.used, stats.total, stats.max_used, stats.failed);
+
+#if defined(CONFIG_BT_MESH_VENDOR_MEM_REPORT)
+	for (int i = 0; i < ARRAY_SIZE(threads) && threads[i]; i++) {
+		size_t unused;
+
+		if (k_thread_stack_space_get(threads[i], &unused)) {
+			continue;
+		}
+
+		LOG_INF("Thread %s: %zu of %zu stack bytes never used",
+			k_thread_name_get(threads[i]) ? k_thread_name_get(threads[i]) : "?",
+			unused, threads[i]->stack_info.size);
+	}
+#endif
+}
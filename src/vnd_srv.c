@@ -4,104 +4,1810 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <string.h>
 #include <zephyr/bluetooth/mesh.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
 #include "../include/vnd_srv.h"
+#include "../include/vnd_pool.h"
+#include "../include/vnd_stats.h"
+#include "vnd_lz.h"
+#include "vnd_peer.h"
 
 LOG_MODULE_REGISTER(vnd_srv, CONFIG_BT_MESH_MODEL_LOG_LEVEL);
 
+/* Keep the payload of every SET as the state to store */
+static void image_store(struct bt_mesh_vendor_srv *srv, const struct net_buf_simple *buf)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_STORE)
+	memcpy(srv->image.data, buf->data, buf->len);
+	srv->image.len = buf->len;
+	srv->image.version = bt_mesh_vendor_version(buf);
+	srv->image.valid = true;
+
+	/* The store is deferred, so repeated SETs only write once */
+	if (!srv->image.stored || srv->image.version != srv->image.stored_version) {
+		bt_mesh_model_data_store_schedule(srv->model);
+	}
+#endif
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+static struct bt_mesh_vendor_srv_base *base_find(struct bt_mesh_vendor_srv *srv, uint16_t addr)
+{
+	for (int i = 0; i < ARRAY_SIZE(srv->delta.bases); i++) {
+		if (srv->delta.bases[i].addr == addr) {
+			return &srv->delta.bases[i];
+		}
+	}
+
+	return NULL;
+}
+#endif
+
+/* Make an accepted SET payload the base of the client's next delta SET, replacing the least
+ * recently used base if the client doesn't have one. Each client has its own base, so clients
+ * writing in turn don't make each other's deltas stale.
+ */
+static void base_store(struct bt_mesh_vendor_srv *srv, uint16_t addr,
+		       const struct net_buf_simple *buf)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	struct bt_mesh_vendor_srv_base *base = base_find(srv, addr);
+
+	if (!base) {
+		base = &srv->delta.bases[0];
+
+		for (int i = 1; i < ARRAY_SIZE(srv->delta.bases); i++) {
+			if (srv->delta.bases[i].seq < base->seq) {
+				base = &srv->delta.bases[i];
+			}
+		}
+	}
+
+	base->addr = addr;
+	base->len = buf->len;
+	base->version = bt_mesh_vendor_version(buf);
+	base->seq = ++srv->delta.seq;
+	memcpy(base->data, buf->data, buf->len);
+#endif
+}
+
+/* Time the set and get handlers, for the handler execution time histogram */
+static uint32_t handler_start(void)
+{
+	return IS_ENABLED(CONFIG_BT_MESH_VENDOR_STATS) ? k_cycle_get_32() : 0;
+}
+
+/* Returns the time spent in the handler in microseconds, or 0 without statistics */
+static uint32_t handler_end(uint32_t start)
+{
+	uint32_t time_us = 0;
+
+	if (IS_ENABLED(CONFIG_BT_MESH_VENDOR_STATS)) {
+		time_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+		_bt_mesh_vendor_stats_hist_add(BT_MESH_VENDOR_STATS_HIST_HANDLER, time_us);
+	}
+
+	return time_us;
+}
+
+/* Note what was published, so change-driven publications skip an unchanged status */
+static void pub_change_sent(struct bt_mesh_vendor_srv *srv, uint32_t version)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_PUB_ON_CHANGE)
+	srv->pub_change.last = k_uptime_get();
+	srv->pub_change.version = version;
+	srv->pub_change.valid = true;
+#endif
+}
+
+/* Start a publication message with the current status from the get handler */
+static int pub_status_fill(struct bt_mesh_vendor_srv *srv, uint32_t *version)
+{
+	struct net_buf_simple data;
+	struct bt_mesh_vendor_status rsp = {
+		.buf = &data,
+		.tid = BT_MESH_VENDOR_TID_NONE,
+	};
+	uint32_t start;
+	int err;
+
+	net_buf_simple_reset(&srv->pub_msg);
+	bt_mesh_model_msg_init(&srv->pub_msg, BT_MESH_VENDOR_OP_STATUS);
+	net_buf_simple_add_u8(&srv->pub_msg, BT_MESH_VENDOR_TID_NONE);
+
+	/* The handler writes straight into the publication message */
+	net_buf_simple_init_with_data(&data, net_buf_simple_tail(&srv->pub_msg),
+				      BT_MESH_VENDOR_MSG_MAXLEN_STATUS);
+	net_buf_simple_reset(&data);
+
+	start = handler_start();
+	err = srv->handlers->get(srv, NULL, NULL, &rsp);
+	handler_end(start);
+
+	if (err) {
+		return err;
+	}
+
+	net_buf_simple_add(&srv->pub_msg, data.len);
+	*version = bt_mesh_vendor_version(&data);
+
+	return 0;
+}
+
+int _bt_mesh_vendor_srv_update_handler(const struct bt_mesh_model *model)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	uint32_t version;
+	int err;
+
+	err = pub_status_fill(srv, &version);
+	if (err) {
+		return err;
+	}
+
+	pub_change_sent(srv, version);
+	_bt_mesh_vendor_stats_tx(&srv->pub_msg);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_PUB_ON_CHANGE)
+static void pub_change_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_mesh_vendor_srv *srv = CONTAINER_OF(dwork, struct bt_mesh_vendor_srv,
+						      pub_change.work);
+	uint32_t version;
+	int err;
+
+	if (srv->pub.addr == BT_MESH_ADDR_UNASSIGNED) {
+		return;
+	}
+
+	err = pub_status_fill(srv, &version);
+	if (err) {
+		return;
+	}
+
+	if (srv->pub_change.valid && srv->pub_change.version == version) {
+		LOG_DBG("Status unchanged, not publishing");
+		return;
+	}
+
+	LOG_DBG("Publishing changed STATUS, data length %d",
+		srv->pub_msg.len - BT_MESH_VENDOR_STATUS_HDR_LEN);
+
+	_bt_mesh_vendor_stats_tx(&srv->pub_msg);
+
+	err = bt_mesh_model_publish(srv->model);
+	if (err) {
+		LOG_WRN("Failed to publish STATUS (err: %d)", err);
+		return;
+	}
+
+	pub_change_sent(srv, version);
+}
+#endif
+
+int bt_mesh_vendor_srv_pub_changed(struct bt_mesh_vendor_srv *srv)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_PUB_ON_CHANGE)
+	int64_t delay = 0;
+
+	if (srv->pub.addr == BT_MESH_ADDR_UNASSIGNED) {
+		return -EADDRNOTAVAIL;
+	}
+
+	if (srv->pub_change.valid) {
+		delay = srv->pub_change.last + CONFIG_BT_MESH_VENDOR_SRV_PUB_INTERVAL -
+			k_uptime_get();
+	}
+
+	/* An already scheduled publication isn't moved, so a burst of changes is published once */
+	k_work_schedule(&srv->pub_change.work, K_MSEC(MAX(delay, 0)));
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+static int not_modified_send(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			     uint8_t tid);
+
+/* Whether an entry is free, or old enough that the client has given up retrying it */
+static bool dup_expired(const struct bt_mesh_vendor_srv_dup *entry, int64_t now)
+{
+	return entry->src == BT_MESH_ADDR_UNASSIGNED ||
+	       now - entry->time > CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE_TIMEOUT;
+}
+
+/* Find the entry of a request, or the entry to replace with it. A client may have several
+ * requests in flight, so every TID has its own entry. Must be called with the cache lock held.
+ */
+static struct bt_mesh_vendor_srv_dup *dup_entry(struct bt_mesh_vendor_srv *srv, uint16_t src,
+						uint8_t tid, int64_t now)
+{
+	struct bt_mesh_vendor_srv_dup *oldest = &srv->dup.entries[0];
+
+	for (int i = 0; i < ARRAY_SIZE(srv->dup.entries); i++) {
+		struct bt_mesh_vendor_srv_dup *entry = &srv->dup.entries[i];
+
+		if (entry->src == src && entry->tid == tid && !dup_expired(entry, now)) {
+			return entry;
+		}
+
+		if (dup_expired(entry, now)) {
+			if (!dup_expired(oldest, now)) {
+				oldest = entry;
+			}
+		} else if (!dup_expired(oldest, now) && entry->time < oldest->time) {
+			oldest = entry;
+		}
+	}
+
+	return oldest;
+}
+
+/* Send the cached response to a command or KV SET again. Must be called with the status data
+ * in the status message.
+ */
+static void dup_rsp_send(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			 uint32_t op, uint8_t tid)
+{
+	uint32_t rsp_op = op == BT_MESH_VENDOR_OP_CMD ? BT_MESH_VENDOR_OP_CMD_STATUS :
+						       BT_MESH_VENDOR_OP_KV_SET_STATUS;
+	struct net_buf_simple msg;
+
+	if (bt_mesh_vendor_pool_buf_get(&msg)) {
+		return;
+	}
+
+	bt_mesh_model_msg_init(&msg, rsp_op);
+	net_buf_simple_add_u8(&msg, tid);
+	net_buf_simple_add_mem(&msg, srv->status_msg.data, srv->status_msg.len);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+	(void)bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+	bt_mesh_vendor_pool_buf_put(&msg);
+}
+
+/* Look a request up in the duplicate cache. Returns 0 if the request is new and must be
+ * passed to the handler, or -EALREADY if it's a retry that has been answered from the cache
+ * or must be dropped.
+ */
+static int dup_check(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint32_t op,
+		     uint8_t tid, uint32_t digest)
+{
+	struct bt_mesh_vendor_srv_dup *entry;
+	k_spinlock_key_t key;
+	int64_t now = k_uptime_get();
+	uint8_t state;
+
+	key = k_spin_lock(&srv->dup.lock);
+
+	entry = dup_entry(srv, ctx->addr, tid, now);
+	if (entry->src != ctx->addr || entry->tid != tid || entry->op != op ||
+	    entry->digest != digest || dup_expired(entry, now)) {
+		entry->src = ctx->addr;
+		entry->tid = tid;
+		entry->op = op;
+		entry->digest = digest;
+		entry->time = now;
+		entry->state = BT_MESH_VENDOR_SRV_DUP_PENDING;
+		k_spin_unlock(&srv->dup.lock, key);
+
+		return 0;
+	}
+
+	state = entry->state;
+	if (state == BT_MESH_VENDOR_SRV_DUP_STATUS) {
+		/* The handler isn't called, so the status message is free */
+		net_buf_simple_reset(&srv->status_msg);
+		net_buf_simple_add_mem(&srv->status_msg, entry->data, entry->len);
+	}
+
+	k_spin_unlock(&srv->dup.lock, key);
+
+	LOG_DBG("Duplicate request from 0x%04x, TID %u state %u", ctx->addr, tid, state);
+
+	switch (state) {
+	case BT_MESH_VENDOR_SRV_DUP_STATUS: {
+		struct bt_mesh_vendor_status rsp = {
+			.buf = &srv->status_msg,
+			.tid = tid,
+		};
+
+		if (op == BT_MESH_VENDOR_OP_CMD || op == BT_MESH_VENDOR_OP_KV_SET) {
+			dup_rsp_send(srv, ctx, op, tid);
+		} else {
+			(void)bt_mesh_vendor_srv_status_send(srv, ctx, &rsp);
+		}
+
+		return -EALREADY;
+	}
+	case BT_MESH_VENDOR_SRV_DUP_NOT_MODIFIED:
+		(void)not_modified_send(srv, ctx, tid);
+		return -EALREADY;
+	case BT_MESH_VENDOR_SRV_DUP_UNCACHED:
+		/* Answering a GET again is harmless, a SET or command must not be applied twice */
+		return op == BT_MESH_VENDOR_OP_GET || op == BT_MESH_VENDOR_OP_GET_COND ? 0 :
+										 -EALREADY;
+	default:
+		/* The response will be sent when the handler gives it */
+		return -EALREADY;
+	}
+}
+
+/* Keep the response to a pending request, data is NULL for a NOT_MODIFIED */
+static void dup_store(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+		      const struct net_buf_simple *data)
+{
+	struct bt_mesh_vendor_srv_dup *entry;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&srv->dup.lock);
+
+	entry = dup_entry(srv, ctx->addr, tid, k_uptime_get());
+	if (entry->src == ctx->addr && entry->tid == tid &&
+	    entry->state == BT_MESH_VENDOR_SRV_DUP_PENDING) {
+		if (!data) {
+			entry->state = BT_MESH_VENDOR_SRV_DUP_NOT_MODIFIED;
+		} else if (data->len <= sizeof(entry->data)) {
+			memcpy(entry->data, data->data, data->len);
+			entry->len = data->len;
+			entry->state = BT_MESH_VENDOR_SRV_DUP_STATUS;
+		} else {
+			entry->state = BT_MESH_VENDOR_SRV_DUP_UNCACHED;
+		}
+	}
+
+	k_spin_unlock(&srv->dup.lock, key);
+}
+
+/* Keep the response to a command or KV SET, from the data after its TID to the end */
+static void dup_rsp_store(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+			  struct net_buf_simple *msg, uint8_t *data)
+{
+	struct net_buf_simple rsp;
+
+	net_buf_simple_init_with_data(&rsp, data, net_buf_simple_tail(msg) - data);
+	dup_store(srv, ctx, tid, &rsp);
+}
+
+/* Forget a pending request that wasn't passed to the handler, so its retry is handled anew */
+static void dup_drop(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid)
+{
+	struct bt_mesh_vendor_srv_dup *entry;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&srv->dup.lock);
+
+	entry = dup_entry(srv, ctx->addr, tid, k_uptime_get());
+	if (entry->src == ctx->addr && entry->tid == tid &&
+	    entry->state == BT_MESH_VENDOR_SRV_DUP_PENDING) {
+		entry->src = BT_MESH_ADDR_UNASSIGNED;
+	}
+
+	k_spin_unlock(&srv->dup.lock, key);
+}
+#else
+static int dup_check(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint32_t op,
+		     uint8_t tid, uint32_t digest)
+{
+	return 0;
+}
+
+static void dup_store(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+		      const struct net_buf_simple *data)
+{
+}
+
+static void dup_rsp_store(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+			  struct net_buf_simple *msg, uint8_t *data)
+{
+}
+
+static void dup_drop(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid)
+{
+}
+#endif
+
+/* Pass a new SET to the set handler, once it's known not to be a retry */
+static void set_apply(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+		      bool compact, struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_set set = {
+		.buf = buf
+	};
+
+	if (srv->handlers && srv->handlers->set) {
+		net_buf_simple_reset(&srv->status_msg);
+		struct bt_mesh_vendor_status rsp = {
+			.buf = &srv->status_msg,
+			.tid = tid,
+			.compact = compact,
+		};
+
+		uint32_t start = handler_start();
+		int err = srv->handlers->set(srv, ctx, &set, &rsp);
+
+		handler_end(start);
+
+		if (err == 0) {
+			/* Only a payload the application accepted is restored on the next start,
+			 * and the client makes it its base once it gets the status
+			 */
+			image_store(srv, buf);
+			base_store(srv, ctx->addr, buf);
+			bt_mesh_vendor_srv_status_send(srv, ctx, &rsp);
+		} else {
+			_bt_mesh_vendor_stats_deferred(compact ? BT_MESH_VENDOR_OP_SET_C :
+								 BT_MESH_VENDOR_OP_SET);
+		}
+
+		/* Let subscribers know without polling, if the status has changed */
+		(void)bt_mesh_vendor_srv_pub_changed(srv);
+	}
+}
+
+static void set_rx(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+		   bool compact, struct net_buf_simple *buf)
+{
+	LOG_DBG("Received SET message, TID %u data length %d", tid, buf->len);
+
+	/* Compact requests have no TID to tell a retry from a new request */
+	if (!compact &&
+	    dup_check(srv, ctx, BT_MESH_VENDOR_OP_SET, tid, bt_mesh_vendor_version(buf))) {
+		return;
+	}
+
+	set_apply(srv, ctx, tid, compact, buf);
+}
+
+/* Pass an unacknowledged payload to the set handler */
+static void set_unack_deliver(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			      struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_set set = {
+		.buf = buf
+	};
+
+	if (srv->handlers && srv->handlers->set) {
+		net_buf_simple_reset(&srv->status_msg);
+		struct bt_mesh_vendor_status rsp = {
+			.buf = &srv->status_msg
+		};
+
+		uint32_t start = handler_start();
+
+		/* Call the same handler but don't send any response */
+		srv->handlers->set(srv, ctx, &set, &rsp);
+		handler_end(start);
+
+		(void)bt_mesh_vendor_srv_pub_changed(srv);
+	}
+}
+
+static void set_unack_rx(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			 struct net_buf_simple *buf)
+{
+	image_store(srv, buf);
+
+	LOG_DBG("Received SET UNACK message, data length %d", buf->len);
+
+	set_unack_deliver(srv, ctx, buf);
+}
+
 static int handle_set(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 		     struct net_buf_simple *buf)
 {
-	if (buf->len > BT_MESH_VENDOR_MSG_MAXLEN_STATUS) {
-		return -EMSGSIZE;
+	uint8_t tid;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_SET, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+	if (buf->len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_SET);
+		return -EMSGSIZE;
+	}
+
+	set_rx(model->rt->user_data, ctx, tid, false, buf);
+
+	return 0;
+}
+
+static int handle_set_c(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			struct net_buf_simple *buf)
+{
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_SET_C, buf->len);
+
+	/* Without a TID there is no replay protection, so only short payloads are accepted */
+	if (buf->len > BT_MESH_VENDOR_MSG_MAXLEN_SET_C) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_SET_C);
+		return -EMSGSIZE;
+	}
+
+	set_rx(model->rt->user_data, ctx, BT_MESH_VENDOR_TID_NONE, true, buf);
+
+	return 0;
+}
+
+static int handle_set_unack(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf)
+{
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_SET_UNACK, buf->len);
+
+	if (buf->len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_SET_UNACK);
+		return -EMSGSIZE;
+	}
+
+	set_unack_rx(model->rt->user_data, ctx, buf);
+
+	return 0;
+}
+
+static int handle_set_unack_batch(const struct bt_mesh_model *model,
+				  struct bt_mesh_msg_ctx *ctx, struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple record;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_SET_UNACK_BATCH, buf->len);
+
+	LOG_DBG("Received SET UNACK BATCH, length %d", buf->len);
+
+	while (buf->len) {
+		uint8_t len = net_buf_simple_pull_u8(buf);
+
+		if (len > buf->len) {
+			LOG_WRN("Truncated SET UNACK BATCH from 0x%04x", ctx->addr);
+			return -EINVAL;
+		}
+
+		net_buf_simple_init_with_data(&record, net_buf_simple_pull_mem(buf, len), len);
+		set_unack_rx(srv, ctx, &record);
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_LZ)
+/* Decompress a received SET or SET_UNACK payload into a pool buffer */
+static int set_decompress(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			  uint32_t op, struct net_buf_simple *buf, struct net_buf_simple *data)
+{
+	int err;
+
+	err = bt_mesh_vendor_pool_buf_get(data);
+	if (err) {
+		return err;
+	}
+
+	err = vnd_lz_decompress_add(data, buf);
+	if (!err && data->len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		_bt_mesh_vendor_stats_rejected(op);
+		err = -EMSGSIZE;
+	}
+
+	if (err) {
+		LOG_WRN("Invalid compressed SET from 0x%04x", ctx->addr);
+		bt_mesh_vendor_pool_buf_put(data);
+		return err;
+	}
+
+	/* Only nodes that support compression send it, so answer in kind */
+	if (BT_MESH_ADDR_IS_UNICAST(ctx->addr)) {
+		vnd_peer_caps_set(srv->peers, ARRAY_SIZE(srv->peers), ctx->addr,
+				  BT_MESH_VENDOR_CAP_LZ);
+	}
+
+	return 0;
+}
+
+static int handle_set_z(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple data;
+	uint8_t tid;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_SET_Z, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+	err = set_decompress(srv, ctx, BT_MESH_VENDOR_OP_SET_Z, buf, &data);
+	if (err) {
+		return err;
+	}
+
+	set_rx(srv, ctx, tid, false, &data);
+	bt_mesh_vendor_pool_buf_put(&data);
+
+	return 0;
+}
+
+static int handle_set_unack_z(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			      struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple data;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_SET_UNACK_Z, buf->len);
+
+	err = set_decompress(srv, ctx, BT_MESH_VENDOR_OP_SET_UNACK_Z, buf, &data);
+	if (err) {
+		return err;
+	}
+
+	set_unack_rx(srv, ctx, &data);
+	bt_mesh_vendor_pool_buf_put(&data);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+static int delta_stale_send(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			    uint8_t tid)
+{
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_DELTA_STALE,
+				 BT_MESH_VENDOR_MSG_LEN_DELTA_STALE);
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_DELTA_STALE);
+	net_buf_simple_add_u8(&msg, tid);
+
+	LOG_DBG("Sending DELTA STALE, TID %u", tid);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+
+	return bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+}
+
+/* Apply the delta ranges in buf to the client's base, rebuilding the payload in out */
+static int delta_apply(const struct bt_mesh_vendor_srv_base *base, struct net_buf_simple *buf,
+		       uint16_t len, struct net_buf_simple *out)
+{
+	size_t keep = MIN(base->len, len);
+
+	net_buf_simple_add_mem(out, base->data, keep);
+	memset(net_buf_simple_add(out, len - keep), 0, len - keep);
+
+	while (buf->len) {
+		uint16_t offset;
+		uint8_t range_len;
+
+		if (buf->len < BT_MESH_VENDOR_DELTA_RANGE_HDR_LEN) {
+			return -EINVAL;
+		}
+
+		offset = net_buf_simple_pull_le16(buf);
+		range_len = net_buf_simple_pull_u8(buf);
+
+		if (!range_len || range_len > buf->len || offset + range_len > len) {
+			return -EINVAL;
+		}
+
+		memcpy(&out->data[offset], net_buf_simple_pull_mem(buf, range_len), range_len);
+	}
+
+	return 0;
+}
+
+static int handle_set_delta(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			    struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct bt_mesh_vendor_srv_base *base;
+	struct net_buf_simple data;
+	uint32_t base_version;
+	uint32_t version;
+	uint16_t len;
+	uint8_t tid;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_SET_DELTA, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+	base_version = net_buf_simple_pull_le32(buf);
+	version = net_buf_simple_pull_le32(buf);
+	len = net_buf_simple_pull_le16(buf);
+
+	LOG_DBG("Received SET DELTA, TID %u base 0x%08x length %u", tid, base_version, len);
+
+	/* Applying the delta moved the base on, so a retry of one that was applied would be
+	 * stale. Answer it from the cache instead, the digest is the version of the result.
+	 */
+	if (dup_check(srv, ctx, BT_MESH_VENDOR_OP_SET, tid, version)) {
+		return 0;
+	}
+
+	/* The client falls back to a full SET when told its base is stale */
+	base = base_find(srv, ctx->addr);
+	if (!base || base->version != base_version || len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
+		dup_drop(srv, ctx, tid);
+		return delta_stale_send(srv, ctx, tid);
+	}
+
+	err = bt_mesh_vendor_pool_buf_get(&data);
+	if (err) {
+		dup_drop(srv, ctx, tid);
+		return err;
+	}
+
+	err = delta_apply(base, buf, len, &data);
+	if (err || bt_mesh_vendor_version(&data) != version) {
+		LOG_WRN("Invalid SET DELTA from 0x%04x", ctx->addr);
+		dup_drop(srv, ctx, tid);
+		err = delta_stale_send(srv, ctx, tid);
+	} else {
+		set_apply(srv, ctx, tid, false, &data);
+	}
+
+	bt_mesh_vendor_pool_buf_put(&data);
+
+	return err;
+}
+#endif
+
+static int handle_caps_get(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			   struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	uint8_t caps;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_CAPS_GET, buf->len);
+
+	caps = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received CAPS GET 0x%02x from 0x%04x", caps, ctx->addr);
+
+	if (BT_MESH_ADDR_IS_UNICAST(ctx->addr)) {
+		vnd_peer_caps_set(srv->peers, ARRAY_SIZE(srv->peers), ctx->addr, caps);
+	}
+
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_CAPS_STATUS, BT_MESH_VENDOR_MSG_LEN_CAPS);
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_CAPS_STATUS);
+	net_buf_simple_add_u8(&msg, VND_CAPS_LOCAL);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+
+	return bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+}
+
+static int not_modified_send(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			     uint8_t tid)
+{
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_NOT_MODIFIED,
+				 BT_MESH_VENDOR_MSG_LEN_NOT_MODIFIED);
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_NOT_MODIFIED);
+	net_buf_simple_add_u8(&msg, tid);
+
+	LOG_DBG("Sending NOT MODIFIED, TID %u", tid);
+
+	dup_store(srv, ctx, tid, NULL);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+
+	return bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+}
+
+/* Answer a GET. If the client passed the version of the data it has, and the data hasn't
+ * changed, only a NOT_MODIFIED is sent.
+ */
+static int get_rx(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx, uint8_t tid,
+		  const struct bt_mesh_vendor_get *get, const uint32_t *version)
+{
+	uint32_t digest = (get ? get->length : BIT(16)) ^ (version ? *version : 0);
+
+	if (dup_check(srv, ctx, version ? BT_MESH_VENDOR_OP_GET_COND : BT_MESH_VENDOR_OP_GET, tid,
+		      digest)) {
+		return 0;
+	}
+
+	net_buf_simple_reset(&srv->status_msg);
+	struct bt_mesh_vendor_status rsp = {
+		.buf = &srv->status_msg,
+		.tid = tid,
+	};
+
+	uint32_t start = handler_start();
+	int err = srv->handlers->get(srv, ctx, get, &rsp);
+
+	handler_end(start);
+
+	/* Send response only if handler returned success */
+	if (err) {
+		_bt_mesh_vendor_stats_deferred(version ? BT_MESH_VENDOR_OP_GET_COND :
+							 BT_MESH_VENDOR_OP_GET);
+		return 0;
+	}
+
+	if (version && bt_mesh_vendor_version(rsp.buf) == *version) {
+		net_buf_simple_reset(&srv->status_msg);
+		return not_modified_send(srv, ctx, tid);
+	}
+
+	return bt_mesh_vendor_srv_status_send(srv, ctx, &rsp);
+}
+
+static int handle_get(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_get get = { 0 };
+	bool has_len = (buf->len == BT_MESH_VENDOR_MSG_MAXLEN_GET);
+	uint8_t tid;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_GET, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+
+	/* Check if the length parameter is included in the message */
+	if (has_len) {
+		get.length = net_buf_simple_pull_le16(buf);
+		LOG_DBG("GET message, TID %u with length parameter: %u", tid, get.length);
+	} else {
+		LOG_DBG("GET message, TID %u without length parameter", tid);
+	}
+
+	return get_rx(model->rt->user_data, ctx, tid, has_len ? &get : NULL, NULL);
+}
+
+static int handle_get_cond(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			   struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_get get = { 0 };
+	bool has_len = (buf->len == BT_MESH_VENDOR_MSG_MAXLEN_GET_COND);
+	uint32_t version;
+	uint8_t tid;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_GET_COND, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+	version = net_buf_simple_pull_le32(buf);
+
+	if (has_len) {
+		get.length = net_buf_simple_pull_le16(buf);
+	}
+
+	LOG_DBG("GET COND message, TID %u version 0x%08x", tid, version);
+
+	return get_rx(model->rt->user_data, ctx, tid, has_len ? &get : NULL, &version);
+}
+
+static int bulk_ack_send(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			 uint8_t id, uint8_t status)
+{
+	const struct bt_mesh_vendor_bulk_ack ack = {
+		.id = id,
+		.status = status,
+		.base = srv->bulk.base,
+		.bitmap = srv->bulk.bitmap,
+	};
+
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_BULK_ACK, BT_MESH_VENDOR_MSG_LEN_BULK_ACK);
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_BULK_ACK);
+	(void)bt_mesh_vendor_bulk_ack_encode(&msg, &ack);
+
+	LOG_DBG("Sending BULK ACK, status %u base %u bitmap 0x%08x", status, srv->bulk.base,
+		srv->bulk.bitmap);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+
+	return bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+}
+
+static bool bulk_owned_by(const struct bt_mesh_vendor_srv *srv, uint16_t src, uint8_t id)
+{
+	return srv->bulk.valid && srv->bulk.src == src && srv->bulk.id == id;
+}
+
+static int handle_bulk_start(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			     struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct bt_mesh_vendor_bulk_start start;
+	uint8_t *data = NULL;
+	uint8_t chunk_size;
+	uint32_t len;
+	uint8_t id;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_BULK_START, buf->len);
+
+	err = bt_mesh_vendor_bulk_start_decode(buf, &start);
+	if (err) {
+		return err;
+	}
+
+	id = start.id;
+	len = start.len;
+	chunk_size = start.chunk_size;
+
+	LOG_DBG("Received BULK START %u, data length %u chunk size %u", id, len, chunk_size);
+
+	/* A repeated start means our acknowledgment was lost */
+	if (bulk_owned_by(srv, ctx->addr, id)) {
+		return bulk_ack_send(srv, ctx, id, srv->bulk.status);
+	}
+
+	/* Don't let another client take over a transfer in progress */
+	if (srv->bulk.valid && srv->bulk.status == BT_MESH_VENDOR_BULK_IN_PROGRESS &&
+	    srv->bulk.src != ctx->addr) {
+		return bulk_ack_send(srv, ctx, id, BT_MESH_VENDOR_BULK_REJECTED);
+	}
+
+	if (chunk_size && len && DIV_ROUND_UP(len, chunk_size) <= BT_MESH_VENDOR_BULK_CHUNK_COUNT_MAX &&
+	    srv->handlers->bulk_start) {
+		data = srv->handlers->bulk_start(srv, ctx, len);
+	}
+
+	if (!data) {
+		srv->bulk.valid = false;
+		return bulk_ack_send(srv, ctx, id, BT_MESH_VENDOR_BULK_REJECTED);
+	}
+
+	srv->bulk.data = data;
+	srv->bulk.len = len;
+	srv->bulk.crc = start.crc;
+	srv->bulk.bitmap = 0;
+	srv->bulk.src = ctx->addr;
+	srv->bulk.count = DIV_ROUND_UP(len, chunk_size);
+	srv->bulk.base = 0;
+	srv->bulk.id = id;
+	srv->bulk.chunk_size = chunk_size;
+	srv->bulk.status = BT_MESH_VENDOR_BULK_IN_PROGRESS;
+	srv->bulk.valid = true;
+
+	return bulk_ack_send(srv, ctx, id, srv->bulk.status);
+}
+
+static void bulk_chunk_store(struct bt_mesh_vendor_srv *srv, uint16_t idx,
+			     struct net_buf_simple *buf)
+{
+	size_t offset = (size_t)idx * srv->bulk.chunk_size;
+	uint16_t bit = idx - srv->bulk.base;
+
+	/* Duplicates, and chunks beyond what the bitmap can track, are dropped. The client
+	 * never sends more than a window ahead of the last acknowledged base.
+	 */
+	if (idx < srv->bulk.base || bit >= 32 || (srv->bulk.bitmap & BIT(bit))) {
+		return;
+	}
+
+	if (buf->len != MIN(srv->bulk.len - offset, srv->bulk.chunk_size)) {
+		LOG_WRN("Invalid BULK CHUNK %u length %u", idx, buf->len);
+		return;
+	}
+
+	memcpy(&srv->bulk.data[offset], buf->data, buf->len);
+	srv->bulk.bitmap |= BIT(bit);
+
+	while (srv->bulk.bitmap & BIT(0)) {
+		srv->bulk.bitmap >>= 1;
+		srv->bulk.base++;
+	}
+}
+
+static int handle_bulk_chunk(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			     struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	uint16_t idx;
+	bool ack_req;
+	uint8_t id;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_BULK_CHUNK, buf->len);
+
+	id = net_buf_simple_pull_u8(buf);
+	idx = net_buf_simple_pull_le16(buf);
+	ack_req = idx & BT_MESH_VENDOR_BULK_ACK_REQ;
+	idx &= ~BT_MESH_VENDOR_BULK_ACK_REQ;
+
+	if (!bulk_owned_by(srv, ctx->addr, id)) {
+		LOG_DBG("BULK CHUNK for unknown transfer %u", id);
+		return ack_req ? bulk_ack_send(srv, ctx, id, BT_MESH_VENDOR_BULK_REJECTED) : 0;
+	}
+
+	if (srv->bulk.status == BT_MESH_VENDOR_BULK_IN_PROGRESS && idx < srv->bulk.count) {
+		bulk_chunk_store(srv, idx, buf);
+
+		if (srv->bulk.base == srv->bulk.count) {
+			bool crc_ok = (crc32_ieee(srv->bulk.data, srv->bulk.len) == srv->bulk.crc);
+
+			srv->bulk.status = crc_ok ? BT_MESH_VENDOR_BULK_COMPLETE :
+						    BT_MESH_VENDOR_BULK_CRC_ERROR;
+			/* Always report the final state, the client is waiting for it */
+			ack_req = true;
+
+			LOG_DBG("BULK transfer %u complete, CRC %s", id, crc_ok ? "ok" : "mismatch");
+
+			if (srv->handlers->bulk_end) {
+				srv->handlers->bulk_end(srv, ctx, srv->bulk.data, srv->bulk.len,
+							crc_ok ? 0 : -EBADMSG);
+			}
+		}
+	}
+
+	return ack_req ? bulk_ack_send(srv, ctx, id, srv->bulk.status) : 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+/* Find the stream of the source, or else a free entry, or else the least recently active
+ * stream. Must be called with the stream lock held.
+ */
+static struct bt_mesh_vendor_srv_stream *stream_find(struct bt_mesh_vendor_srv *srv, uint16_t src)
+{
+	struct bt_mesh_vendor_srv_stream *oldest = &srv->stream.streams[0];
+	struct bt_mesh_vendor_srv_stream *free = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(srv->stream.streams); i++) {
+		struct bt_mesh_vendor_srv_stream *stream = &srv->stream.streams[i];
+
+		if (stream->src == BT_MESH_ADDR_UNASSIGNED) {
+			free = free ? free : stream;
+		} else if (stream->src == src) {
+			return stream;
+		} else if (stream->last < oldest->last) {
+			oldest = stream;
+		}
+	}
+
+	return free ? free : oldest;
+}
+
+/* Move the window to a record ahead of the ones received, marking the skipped records as
+ * missing. Returns the number of missing records that fall out of the window.
+ */
+static uint32_t stream_advance(struct bt_mesh_vendor_srv_stream *stream, uint16_t skipped)
+{
+	uint32_t lost;
+	uint64_t bits;
+
+	if (skipped >= BT_MESH_VENDOR_STREAM_WINDOW) {
+		lost = __builtin_popcount(stream->missing) + skipped -
+		       (BT_MESH_VENDOR_STREAM_WINDOW - 1);
+		bits = BIT64_MASK(BT_MESH_VENDOR_STREAM_WINDOW - 1) << 1;
+	} else {
+		bits = ((uint64_t)stream->missing << (skipped + 1)) | (BIT64_MASK(skipped) << 1);
+		lost = __builtin_popcount(bits >> BT_MESH_VENDOR_STREAM_WINDOW);
+	}
+
+	stream->missing = bits;
+	stream->next += skipped + 1;
+
+	return lost;
+}
+
+static int stream_nack_send(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			    const struct bt_mesh_vendor_stream_nack *nack)
+{
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_STREAM_NACK,
+				 BT_MESH_VENDOR_MSG_LEN_STREAM_NACK);
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_STREAM_NACK);
+	(void)bt_mesh_vendor_stream_nack_encode(&msg, nack);
+
+	LOG_DBG("Sending STREAM NACK to 0x%04x, next %u missing 0x%08x", ctx->addr, nack->next,
+		nack->missing);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+
+	return bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+}
+
+static void stream_nack_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_mesh_vendor_srv *srv = CONTAINER_OF(dwork, struct bt_mesh_vendor_srv,
+						      stream.nack_work);
+	bool again = false;
+
+	for (int i = 0; i < ARRAY_SIZE(srv->stream.streams); i++) {
+		struct bt_mesh_vendor_srv_stream *stream = &srv->stream.streams[i];
+		struct bt_mesh_msg_ctx ctx = {
+			.send_ttl = BT_MESH_TTL_DEFAULT,
+		};
+		struct bt_mesh_vendor_stream_nack nack;
+		k_spinlock_key_t key;
+		uint32_t lost = 0;
+		bool send = false;
+
+		key = k_spin_lock(&srv->stream.lock);
+
+		ctx.addr = stream->src;
+
+		if (stream->missing && stream->nacks < CONFIG_BT_MESH_VENDOR_STREAM_NACK_RETRIES) {
+			nack.id = stream->id;
+			nack.next = stream->next;
+			nack.missing = stream->missing;
+			ctx.net_idx = stream->net_idx;
+			ctx.app_idx = stream->app_idx;
+			stream->nacks++;
+			send = true;
+		} else if (stream->missing) {
+			lost = __builtin_popcount(stream->missing);
+			stream->missing = 0;
+		}
+
+		k_spin_unlock(&srv->stream.lock, key);
+
+		if (lost) {
+			LOG_WRN("Gave up on %u stream records from 0x%04x", lost, ctx.addr);
+		}
+
+		/* Check again after the delay, and ask again if the records are still missing */
+		if (send) {
+			(void)stream_nack_send(srv, &ctx, &nack);
+			again = true;
+		}
+	}
+
+	if (again) {
+		k_work_schedule(&srv->stream.nack_work,
+				K_MSEC(CONFIG_BT_MESH_VENDOR_STREAM_NACK_DELAY));
+	}
+}
+
+static int handle_stream(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			 struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct bt_mesh_vendor_srv_stream *stream;
+	struct bt_mesh_vendor_stream_hdr hdr;
+	k_spinlock_key_t key;
+	bool deliver = true;
+	bool gap = false;
+	uint32_t lost = 0;
+	int16_t ahead;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_STREAM, buf->len);
+
+	err = bt_mesh_vendor_stream_hdr_decode(buf, &hdr);
+	if (err) {
+		return err;
+	}
+
+	if (buf->len > BT_MESH_VENDOR_STREAM_DATA_MAXLEN) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_STREAM);
+		return -EMSGSIZE;
+	}
+
+	key = k_spin_lock(&srv->stream.lock);
+
+	/* A new stream ID from the client starts over from sequence number 0 */
+	stream = stream_find(srv, ctx->addr);
+	if (stream->src != ctx->addr || stream->id != hdr.id) {
+		*stream = (struct bt_mesh_vendor_srv_stream){
+			.src = ctx->addr,
+			.id = hdr.id,
+		};
+	}
+
+	stream->net_idx = ctx->net_idx;
+	stream->app_idx = ctx->app_idx;
+	stream->last = k_uptime_get();
+
+	ahead = hdr.seq - stream->next;
+	if (ahead >= 0) {
+		lost = stream_advance(stream, ahead);
+		gap = ahead > 0;
+	} else if (-ahead <= BT_MESH_VENDOR_STREAM_WINDOW &&
+		   (stream->missing & BIT(-ahead - 1))) {
+		/* One of the missing records, sent again */
+		stream->missing &= ~BIT(-ahead - 1);
+	} else {
+		deliver = false;
+	}
+
+	if (gap) {
+		stream->nacks = 0;
+	}
+
+	k_spin_unlock(&srv->stream.lock, key);
+
+	if (lost) {
+		LOG_WRN("Lost %u stream records from 0x%04x", lost, ctx->addr);
+	}
+
+	/* Give late records a chance to arrive before asking for them */
+	if (gap) {
+		k_work_schedule(&srv->stream.nack_work,
+				K_MSEC(CONFIG_BT_MESH_VENDOR_STREAM_NACK_DELAY));
+	}
+
+	if (!deliver) {
+		LOG_DBG("Dropped STREAM record %u from 0x%04x", hdr.seq, ctx->addr);
+		return 0;
+	}
+
+	LOG_DBG("Received STREAM record %u, data length %d", hdr.seq, buf->len);
+
+	/* Only the newest record is the server's current state */
+	if (ahead >= 0) {
+		image_store(srv, buf);
+	}
+
+	set_unack_deliver(srv, ctx, buf);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+static int handle_stats_get(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			    struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple msg;
+	uint8_t kind;
+	uint8_t arg;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_STATS_GET, buf->len);
+
+	kind = net_buf_simple_pull_u8(buf);
+	arg = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received STATS GET %u/0x%02x from 0x%04x", kind, arg, ctx->addr);
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_STATS_STATUS);
+	net_buf_simple_add_u8(&msg, kind);
+	net_buf_simple_add_u8(&msg, arg);
+
+	/* Unknown statistics are answered with the request only */
+	(void)bt_mesh_vendor_stats_encode(&msg, kind, arg);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+	err = bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_CMD)
+/* Look the command up by ID, check its parameter length and run its handler */
+static uint8_t cmd_dispatch(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			    uint8_t id, struct net_buf_simple *params, struct net_buf_simple *rsp)
+{
+	const struct bt_mesh_vendor_cmd *cmd;
+	uint32_t start;
+	int err;
+
+	if (id >= srv->handlers->cmd_count || !srv->handlers->cmds[id].handler) {
+		return BT_MESH_VENDOR_CMD_UNKNOWN;
+	}
+
+	cmd = &srv->handlers->cmds[id];
+
+	if (params->len < cmd->min_len || params->len > cmd->max_len) {
+		_bt_mesh_vendor_stats_cmd(id, BT_MESH_VENDOR_CMD_INVALID_LEN, 0);
+		return BT_MESH_VENDOR_CMD_INVALID_LEN;
+	}
+
+	start = handler_start();
+	err = cmd->handler(srv, ctx, params, rsp);
+	_bt_mesh_vendor_stats_cmd(id, err ? BT_MESH_VENDOR_CMD_FAILED : BT_MESH_VENDOR_CMD_SUCCESS,
+				  handler_end(start));
+
+	if (err) {
+		LOG_DBG("Command 0x%02x failed (err: %d)", id, err);
+		return BT_MESH_VENDOR_CMD_FAILED;
+	}
+
+	return BT_MESH_VENDOR_CMD_SUCCESS;
+}
+
+static int handle_cmd(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		      struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple msg;
+	struct net_buf_simple rsp;
+	uint8_t *data;
+	uint8_t result;
+	uint8_t tid;
+	uint8_t id;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_CMD, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+
+	/* Commands may not be safe to run twice, so a retry gets the cached response */
+	if (dup_check(srv, ctx, BT_MESH_VENDOR_OP_CMD, tid, bt_mesh_vendor_version(buf))) {
+		return 0;
+	}
+
+	id = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received CMD 0x%02x, TID %u parameter length %u", id, tid, buf->len);
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		dup_drop(srv, ctx, tid);
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_CMD_STATUS);
+	net_buf_simple_add_u8(&msg, tid);
+	data = net_buf_simple_tail(&msg);
+	net_buf_simple_add_u8(&msg, id);
+
+	/* The handler writes its response straight into the message, after the result */
+	net_buf_simple_init_with_data(&rsp, net_buf_simple_tail(&msg) + 1,
+				      BT_MESH_VENDOR_CMD_RSP_MAXLEN);
+	net_buf_simple_reset(&rsp);
+
+	result = cmd_dispatch(srv, ctx, id, buf, &rsp);
+	if (result != BT_MESH_VENDOR_CMD_SUCCESS) {
+		net_buf_simple_reset(&rsp);
+	}
+
+	net_buf_simple_add_u8(&msg, result);
+	net_buf_simple_add(&msg, rsp.len);
+	dup_rsp_store(srv, ctx, tid, &msg, data);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+	err = bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_PAGE)
+/* Read a page into the data buffer. Returns the result, and the total length of the dataset
+ * on success or if the offset is past the end.
+ */
+static uint8_t page_read(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			 uint32_t offset, struct net_buf_simple *data, uint32_t *total)
+{
+	uint32_t start;
+	int ret;
+
+	if (!srv->handlers->page_read) {
+		return BT_MESH_VENDOR_PAGE_NOT_SUPPORTED;
+	}
+
+	start = handler_start();
+	ret = srv->handlers->page_read(srv, ctx, offset, data);
+	handler_end(start);
+
+	if (ret < 0) {
+		LOG_DBG("Page read at offset %u failed (err: %d)", offset, ret);
+		return BT_MESH_VENDOR_PAGE_FAILED;
+	}
+
+	*total = ret;
+
+	if (offset > *total) {
+		return BT_MESH_VENDOR_PAGE_OUT_OF_RANGE;
+	}
+
+	/* Don't send anything past the end the handler reported */
+	if (data->len > *total - offset) {
+		data->len = *total - offset;
+	}
+
+	return BT_MESH_VENDOR_PAGE_SUCCESS;
+}
+
+static int handle_get_page(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			   struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct bt_mesh_vendor_get_page get;
+	struct bt_mesh_vendor_page_hdr hdr = { 0 };
+	struct net_buf_simple msg;
+	struct net_buf_simple data;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_GET_PAGE, buf->len);
+
+	err = bt_mesh_vendor_get_page_decode(buf, &get);
+	if (err) {
+		return err;
+	}
+
+	LOG_DBG("Received GET PAGE, TID %u offset %u length %u", get.tid, get.offset, get.len);
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_PAGE_STATUS);
+
+	/* The handler reads the page straight into the message, after the header */
+	net_buf_simple_init_with_data(&data,
+				      net_buf_simple_tail(&msg) +
+					      BT_MESH_VENDOR_MSG_MINLEN_PAGE_STATUS,
+				      MIN(get.len, BT_MESH_VENDOR_PAGE_DATA_MAXLEN));
+	net_buf_simple_reset(&data);
+
+	hdr.tid = get.tid;
+	hdr.result = page_read(srv, ctx, get.offset, &data, &hdr.total);
+	if (hdr.result != BT_MESH_VENDOR_PAGE_SUCCESS) {
+		net_buf_simple_reset(&data);
+	}
+
+	(void)bt_mesh_vendor_page_hdr_encode(&msg, &hdr);
+	net_buf_simple_add(&msg, data.len);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+	err = bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+/* Binary search of the key table, which is sorted by key */
+static const struct bt_mesh_vendor_kv *kv_find(const struct bt_mesh_vendor_srv *srv, uint8_t key)
+{
+	size_t lo = 0;
+	size_t hi = srv->handlers->kv_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		const struct bt_mesh_vendor_kv *kv = &srv->handlers->kvs[mid];
+
+		if (kv->key == key) {
+			return kv;
+		}
+
+		if (kv->key < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
 	}
 
-	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
-	struct bt_mesh_vendor_set set = {
-		.buf = buf
+	return NULL;
+}
+
+/* Add a record with the current value of a key, or an empty record if the server doesn't have
+ * the key. Returns -ENOBUFS if the record doesn't fit in the message.
+ */
+static int kv_rec_add(struct net_buf_simple *msg, uint8_t key, const struct bt_mesh_vendor_kv *kv)
+{
+	const struct bt_mesh_vendor_kv_rec_hdr hdr = {
+		.key = key,
+		.len = kv ? kv->len : 0,
 	};
 
-	LOG_DBG("Received SET message, data length %d", buf->len);
+	/* Leave room for the TransMIC */
+	if (net_buf_simple_tailroom(msg) <
+	    BT_MESH_MIC_SHORT + BT_MESH_VENDOR_KV_REC_HDR_LEN + hdr.len) {
+		return -ENOBUFS;
+	}
 
-	if (srv->handlers && srv->handlers->set) {
-		net_buf_simple_reset(&srv->status_msg);
-		struct bt_mesh_vendor_status rsp = {
-			.buf = &srv->status_msg
-		};
+	(void)bt_mesh_vendor_kv_rec_hdr_encode(msg, &hdr);
 
-		int err = srv->handlers->set(srv, ctx, &set, &rsp);
+	if (kv) {
+		net_buf_simple_add_mem(msg, kv->value, kv->len);
+	}
 
-		if (err == 0) {
-			bt_mesh_vendor_srv_status_send(srv, ctx, &rsp);
-		}
+	return 0;
+}
+
+/* Note a changed key, to be published with the other keys changed at about the same time */
+static int kv_mark(struct bt_mesh_vendor_srv *srv, const struct bt_mesh_vendor_kv *kv)
+{
+	size_t idx = kv - srv->handlers->kvs;
+	k_spinlock_key_t key;
+
+	if (srv->pub.addr == BT_MESH_ADDR_UNASSIGNED) {
+		return -EADDRNOTAVAIL;
 	}
 
+	key = k_spin_lock(&srv->kv.lock);
+	srv->kv.changed[idx / 32] |= BIT(idx % 32);
+	k_spin_unlock(&srv->kv.lock, key);
+
+	/* An already scheduled publication isn't moved, so keys changed together go out once */
+	k_work_schedule(&srv->kv.work, K_MSEC(CONFIG_BT_MESH_VENDOR_KV_PUB_DELAY));
+
 	return 0;
 }
 
-static int handle_set_unack(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
-		     struct net_buf_simple *buf)
+/* Clear the changed flag of a key, returns whether it was set */
+static bool kv_changed_take(struct bt_mesh_vendor_srv *srv, size_t idx)
 {
-	if (buf->len > BT_MESH_VENDOR_MSG_MAXLEN_STATUS) {
-		return -EMSGSIZE;
+	k_spinlock_key_t key = k_spin_lock(&srv->kv.lock);
+	bool changed = srv->kv.changed[idx / 32] & BIT(idx % 32);
+
+	srv->kv.changed[idx / 32] &= ~BIT(idx % 32);
+	k_spin_unlock(&srv->kv.lock, key);
+
+	return changed;
+}
+
+static void kv_pub_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_mesh_vendor_srv *srv = CONTAINER_OF(dwork, struct bt_mesh_vendor_srv, kv.work);
+	int count = 0;
+	int err;
+
+	if (srv->pub.addr == BT_MESH_ADDR_UNASSIGNED) {
+		return;
 	}
 
-	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
-	struct bt_mesh_vendor_set set = {
-		.buf = buf
-	};
+	net_buf_simple_reset(&srv->pub_msg);
+	bt_mesh_model_msg_init(&srv->pub_msg, BT_MESH_VENDOR_OP_KV_STATUS);
+	net_buf_simple_add_u8(&srv->pub_msg, BT_MESH_VENDOR_TID_NONE);
 
-	LOG_DBG("Received SET UNACK message, data length %d", buf->len);
+	for (size_t i = 0; i < srv->handlers->kv_count; i++) {
+		const struct bt_mesh_vendor_kv *kv = &srv->handlers->kvs[i];
 
-	if (srv->handlers && srv->handlers->set) {
-		net_buf_simple_reset(&srv->status_msg);
-		struct bt_mesh_vendor_status rsp = {
-			.buf = &srv->status_msg
-		};
+		if (!kv_changed_take(srv, i)) {
+			continue;
+		}
 
-		/* Call the same handler but don't send any response */
-		srv->handlers->set(srv, ctx, &set, &rsp);
+		/* Keys that don't fit go out in the next publication */
+		if (kv_rec_add(&srv->pub_msg, kv->key, kv)) {
+			(void)kv_mark(srv, kv);
+			break;
+		}
+
+		count++;
+	}
+
+	if (!count) {
+		return;
+	}
+
+	LOG_DBG("Publishing %d changed keys", count);
+
+	_bt_mesh_vendor_stats_tx(&srv->pub_msg);
+
+	err = bt_mesh_model_publish(srv->model);
+	if (err) {
+		LOG_WRN("Failed to publish KV STATUS (err: %d)", err);
+	}
+}
+
+/* Check every record of a KV SET before writing any, so a malformed message changes nothing */
+static int kv_recs_check(struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_kv_rec_hdr hdr;
+	struct net_buf_simple_state state;
+	int err = 0;
+
+	net_buf_simple_save(buf, &state);
+
+	while (buf->len) {
+		if (bt_mesh_vendor_kv_rec_hdr_decode(buf, &hdr) || buf->len < hdr.len) {
+			err = -EINVAL;
+			break;
+		}
+
+		net_buf_simple_pull(buf, hdr.len);
+	}
+
+	net_buf_simple_restore(buf, &state);
+
+	return err;
+}
+
+/* Write the records of a KV SET, adding the keys that can't be written to the response if
+ * there is one
+ */
+static int kv_set_rx(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf, struct net_buf_simple *rejected)
+{
+	struct bt_mesh_vendor_kv_rec_hdr hdr;
+	int err;
+
+	err = kv_recs_check(buf);
+	if (err) {
+		LOG_WRN("Malformed KV SET from 0x%04x", ctx->addr);
+		return err;
+	}
+
+	while (buf->len) {
+		const struct bt_mesh_vendor_kv *kv;
+		const uint8_t *value;
+
+		(void)bt_mesh_vendor_kv_rec_hdr_decode(buf, &hdr);
+		value = net_buf_simple_pull_mem(buf, hdr.len);
+		kv = kv_find(srv, hdr.key);
+
+		if (!kv || !kv->writable || hdr.len != kv->len) {
+			LOG_DBG("KV SET of key 0x%02x length %u rejected", hdr.key, hdr.len);
+			if (rejected) {
+				net_buf_simple_add_u8(rejected, hdr.key);
+			}
+
+			continue;
+		}
+
+		/* Rewriting the same value is no change, nobody needs to hear about it */
+		if (!memcmp(kv->value, value, kv->len)) {
+			continue;
+		}
+
+		memcpy(kv->value, value, kv->len);
+
+		if (srv->handlers->kv_changed) {
+			srv->handlers->kv_changed(srv, ctx, kv);
+		}
+
+		(void)kv_mark(srv, kv);
 	}
 
 	return 0;
 }
 
-static int handle_get(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
-		     struct net_buf_simple *buf)
+static int handle_kv_get(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			 struct net_buf_simple *buf)
 {
 	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
-	struct bt_mesh_vendor_get get = { 0 };
-	bool has_len = (buf->len == BT_MESH_VENDOR_MSG_MAXLEN_GET);
+	struct net_buf_simple msg;
+	uint8_t tid;
+	int err;
 
-	/* Check if the length parameter is included in the message */
-	if (has_len) {
-		get.length = net_buf_simple_pull_le16(buf);
-		LOG_DBG("GET message with length parameter: %u", get.length);
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_KV_GET, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+
+	LOG_DBG("Received KV GET, TID %u for %u keys", tid, buf->len);
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_KV_STATUS);
+	net_buf_simple_add_u8(&msg, tid);
+
+	/* Keys that don't fit are left out, for the client to ask for again */
+	while (buf->len) {
+		uint8_t key = net_buf_simple_pull_u8(buf);
+
+		if (kv_rec_add(&msg, key, kv_find(srv, key))) {
+			break;
+		}
+	}
+
+	_bt_mesh_vendor_stats_tx(&msg);
+	err = bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+
+static int handle_kv_set(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			 struct net_buf_simple *buf)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple msg;
+	uint8_t *data;
+	uint8_t tid;
+	int err;
+
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_KV_SET, buf->len);
+
+	tid = net_buf_simple_pull_u8(buf);
+
+	/* A retry gets the cached response, so the change handlers only see the SET once */
+	if (dup_check(srv, ctx, BT_MESH_VENDOR_OP_KV_SET, tid, bt_mesh_vendor_version(buf))) {
+		return 0;
+	}
+
+	LOG_DBG("Received KV SET, TID %u records length %u", tid, buf->len);
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		dup_drop(srv, ctx, tid);
+		return err;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_KV_SET_STATUS);
+	net_buf_simple_add_u8(&msg, tid);
+	data = net_buf_simple_tail(&msg);
+
+	err = kv_set_rx(srv, ctx, buf, &msg);
+	if (err) {
+		/* Nothing was written */
+		dup_drop(srv, ctx, tid);
 	} else {
-		LOG_DBG("GET message without length parameter");
+		dup_rsp_store(srv, ctx, tid, &msg, data);
+		_bt_mesh_vendor_stats_tx(&msg);
+		err = bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
 	}
 
-	net_buf_simple_reset(&srv->status_msg);
-	struct bt_mesh_vendor_status rsp = {
-		.buf = &srv->status_msg
-	};
+	bt_mesh_vendor_pool_buf_put(&msg);
 
-	int err = srv->handlers->get(srv, ctx, has_len ? &get : NULL, &rsp);
+	return err;
+}
 
-	/* Send response only if handler returned success */
-	if (err == 0) {
-		return bt_mesh_vendor_srv_status_send(srv, ctx, &rsp);
+static int handle_kv_set_unack(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			       struct net_buf_simple *buf)
+{
+	_bt_mesh_vendor_stats_rx(BT_MESH_VENDOR_OP_KV_SET_UNACK, buf->len);
+
+	LOG_DBG("Received KV SET UNACK, records length %u", buf->len);
+
+	return kv_set_rx(model->rt->user_data, ctx, buf, NULL);
+}
+#endif
+
+int bt_mesh_vendor_srv_kv_changed(struct bt_mesh_vendor_srv *srv, uint8_t key)
+{
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	const struct bt_mesh_vendor_kv *kv = kv_find(srv, key);
+
+	if (!kv) {
+		return -ENOENT;
 	}
 
-	return 0;
+	return kv_mark(srv, kv);
+#else
+	return -ENOTSUP;
+#endif
 }
 
 const struct bt_mesh_model_op _bt_mesh_vendor_srv_op[] = {
-	{ BT_MESH_VENDOR_OP_SET, 0, handle_set },
+	{ BT_MESH_VENDOR_OP_SET, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_SET), handle_set },
 	{ BT_MESH_VENDOR_OP_SET_UNACK, 0, handle_set_unack },
-	{ BT_MESH_VENDOR_OP_GET, 0, handle_get },
+	{ BT_MESH_VENDOR_OP_SET_C, 0, handle_set_c },
+	{ BT_MESH_VENDOR_OP_SET_UNACK_BATCH,
+	  BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_SET_UNACK_BATCH), handle_set_unack_batch },
+	{ BT_MESH_VENDOR_OP_GET, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_GET), handle_get },
+	{ BT_MESH_VENDOR_OP_GET_COND, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_GET_COND),
+	  handle_get_cond },
+	{ BT_MESH_VENDOR_OP_BULK_START, BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_BULK_START),
+	  handle_bulk_start },
+	{ BT_MESH_VENDOR_OP_BULK_CHUNK, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_BULK_CHUNK),
+	  handle_bulk_chunk },
+#if defined(CONFIG_BT_MESH_VENDOR_LZ)
+	{ BT_MESH_VENDOR_OP_SET_Z, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_SET), handle_set_z },
+	{ BT_MESH_VENDOR_OP_SET_UNACK_Z, 0, handle_set_unack_z },
+#endif
+	{ BT_MESH_VENDOR_OP_CAPS_GET, BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_CAPS),
+	  handle_caps_get },
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	{ BT_MESH_VENDOR_OP_SET_DELTA, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_SET_DELTA),
+	  handle_set_delta },
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STATS)
+	{ BT_MESH_VENDOR_OP_STATS_GET, BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_STATS_GET),
+	  handle_stats_get },
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_CMD)
+	{ BT_MESH_VENDOR_OP_CMD, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_CMD), handle_cmd },
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	{ BT_MESH_VENDOR_OP_STREAM, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_STREAM),
+	  handle_stream },
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_PAGE)
+	{ BT_MESH_VENDOR_OP_GET_PAGE, BT_MESH_LEN_EXACT(BT_MESH_VENDOR_MSG_LEN_GET_PAGE),
+	  handle_get_page },
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	{ BT_MESH_VENDOR_OP_KV_GET, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_KV_GET),
+	  handle_kv_get },
+	{ BT_MESH_VENDOR_OP_KV_SET, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_KV_SET),
+	  handle_kv_set },
+	{ BT_MESH_VENDOR_OP_KV_SET_UNACK, BT_MESH_LEN_MIN(BT_MESH_VENDOR_MSG_MINLEN_KV_SET_UNACK),
+	  handle_kv_set_unack },
+#endif
 	BT_MESH_MODEL_OP_END,
 };
 
@@ -110,10 +1816,23 @@ static int vendor_srv_init(const struct bt_mesh_model *model)
 	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
 
 	srv->model = model;
+	srv->pub.msg = &srv->pub_msg;
 	net_buf_simple_init_with_data(&srv->pub_msg, srv->buf, sizeof(srv->buf));
-	net_buf_simple_init_with_data(&srv->status_msg, srv->status_buf_data, sizeof(srv->status_buf_data));
+	net_buf_simple_init_with_data(&srv->status_msg,
+				      &srv->status_buf_data[BT_MESH_VENDOR_STATUS_HDR_LEN],
+				      BT_MESH_VENDOR_MSG_MAXLEN_STATUS);
 	bt_mesh_model_msg_init(&srv->pub_msg, BT_MESH_VENDOR_OP_STATUS);
+	net_buf_simple_add_u8(&srv->pub_msg, BT_MESH_VENDOR_TID_NONE);
 	net_buf_simple_reset(&srv->status_msg);
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_PUB_ON_CHANGE)
+	k_work_init_delayable(&srv->pub_change.work, pub_change_work);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	k_work_init_delayable(&srv->stream.nack_work, stream_nack_work);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	k_work_init_delayable(&srv->kv.work, kv_pub_work);
+#endif
 
 	/* Make sure get set handlers are set*/
 	if (!srv->handlers || !srv->handlers->get || !srv->handlers->set) {
@@ -121,39 +1840,314 @@ static int vendor_srv_init(const struct bt_mesh_model *model)
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	if (srv->handlers->kv_count > CONFIG_BT_MESH_VENDOR_KV_COUNT) {
+		LOG_ERR("Key table has more than %d keys", CONFIG_BT_MESH_VENDOR_KV_COUNT);
+		return -EINVAL;
+	}
+
+	/* Keys are looked up with a binary search */
+	for (size_t i = 0; i < srv->handlers->kv_count; i++) {
+		if (!srv->handlers->kvs[i].len) {
+			LOG_ERR("Key 0x%02x has no value", srv->handlers->kvs[i].key);
+			return -EINVAL;
+		}
+
+		if (i && srv->handlers->kvs[i].key <= srv->handlers->kvs[i - 1].key) {
+			LOG_ERR("Key table isn't sorted by key at key 0x%02x",
+				srv->handlers->kvs[i].key);
+			return -EINVAL;
+		}
+	}
+#endif
+
 	return 0;
 }
 
 static void vendor_srv_reset(const struct bt_mesh_model *model)
 {
 	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM) || defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE) || \
+	defined(CONFIG_BT_MESH_VENDOR_KV)
+	k_spinlock_key_t key;
+#endif
 
 	net_buf_simple_reset(&srv->status_msg);
 	net_buf_simple_reset(&srv->pub_msg);
 	bt_mesh_model_msg_init(&srv->pub_msg, BT_MESH_VENDOR_OP_STATUS);
+	net_buf_simple_add_u8(&srv->pub_msg, BT_MESH_VENDOR_TID_NONE);
+	srv->bulk.valid = false;
+	memset(srv->peers, 0, sizeof(srv->peers));
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_PUB_ON_CHANGE)
+	k_work_cancel_delayable(&srv->pub_change.work);
+	srv->pub_change.valid = false;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_STREAM)
+	k_work_cancel_delayable(&srv->stream.nack_work);
+	key = k_spin_lock(&srv->stream.lock);
+	memset(srv->stream.streams, 0, sizeof(srv->stream.streams));
+	k_spin_unlock(&srv->stream.lock, key);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+	key = k_spin_lock(&srv->dup.lock);
+	memset(srv->dup.entries, 0, sizeof(srv->dup.entries));
+	k_spin_unlock(&srv->dup.lock, key);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	k_work_cancel_delayable(&srv->kv.work);
+	key = k_spin_lock(&srv->kv.lock);
+	memset(srv->kv.changed, 0, sizeof(srv->kv.changed));
+	k_spin_unlock(&srv->kv.lock, key);
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+	memset(srv->delta.bases, 0, sizeof(srv->delta.bases));
+	srv->delta.seq = 0;
+#endif
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_STORE)
+	srv->image.valid = false;
+	srv->image.stored = false;
+	(void)bt_mesh_model_data_store(model, true, NULL, NULL, 0);
+#endif
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_STORE)
+static int vendor_srv_settings_set(const struct bt_mesh_model *model, const char *name,
+				   size_t len_rd, settings_read_cb read_cb, void *cb_arg)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple buf;
+	ssize_t len;
+
+	if (name) {
+		return -ENOENT;
+	}
+
+	if (len_rd > sizeof(srv->image.data)) {
+		return -EINVAL;
+	}
+
+	len = read_cb(cb_arg, srv->image.data, len_rd);
+	if (len < 0) {
+		return len;
+	}
+
+	net_buf_simple_init_with_data(&buf, srv->image.data, len);
+	srv->image.len = len;
+	srv->image.version = bt_mesh_vendor_version(&buf);
+	srv->image.valid = true;
+	srv->image.stored_version = srv->image.version;
+	srv->image.stored = true;
+
+	return 0;
+}
+
+static int vendor_srv_start(const struct bt_mesh_model *model)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	struct net_buf_simple buf;
+	struct bt_mesh_vendor_set set = {
+		.buf = &buf,
+	};
+
+	/* Nothing is received before the stack starts, so a valid image was restored */
+	if (!srv->image.valid || !srv->handlers->restore) {
+		return 0;
+	}
+
+	net_buf_simple_init_with_data(&buf, srv->image.data, srv->image.len);
+	srv->handlers->restore(srv, &set);
+
+	return 0;
+}
+
+static void vendor_srv_pending_store(const struct bt_mesh_model *model)
+{
+	struct bt_mesh_vendor_srv *srv = model->rt->user_data;
+	int err;
+
+	/* Changed back to the stored payload before the write was due */
+	if (!srv->image.valid ||
+	    (srv->image.stored && srv->image.version == srv->image.stored_version)) {
+		return;
+	}
+
+	/* An empty payload deletes the entry, which restores as no state */
+	err = bt_mesh_model_data_store(model, true, NULL, srv->image.data, srv->image.len);
+	if (err) {
+		LOG_ERR("Failed to store state (err: %d)", err);
+		return;
+	}
+
+	srv->image.stored_version = srv->image.version;
+	srv->image.stored = true;
 }
+#endif
 
 const struct bt_mesh_model_cb _bt_mesh_vendor_srv_cb = {
 	.init = vendor_srv_init,
 	.reset = vendor_srv_reset,
+#if defined(CONFIG_BT_MESH_VENDOR_SRV_STORE)
+	.settings_set = vendor_srv_settings_set,
+	.start = vendor_srv_start,
+	.pending_store = vendor_srv_pending_store,
+#endif
 };
 
+/* Start a STATUS message, or a compact STATUS without the TID if the request was compact */
+static void status_hdr_add(struct net_buf_simple *msg, const struct bt_mesh_vendor_status *rsp)
+{
+	if (rsp->compact) {
+		bt_mesh_model_msg_init(msg, BT_MESH_VENDOR_OP_STATUS_C);
+	} else {
+		bt_mesh_model_msg_init(msg, BT_MESH_VENDOR_OP_STATUS);
+		net_buf_simple_add_u8(msg, rsp->tid);
+	}
+}
+
+/* The handler wrote the data right behind the room reserved for the header, so only the
+ * header needs to be filled in. A compact header is one byte shorter, so it starts one byte
+ * later.
+ */
+static int status_send_in_place(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+				struct bt_mesh_vendor_status *rsp)
+{
+	size_t offset = rsp->compact ? BT_MESH_VENDOR_TID_LEN : 0;
+	struct net_buf_simple msg;
+
+	net_buf_simple_init_with_data(&msg, &srv->status_buf_data[offset],
+				      sizeof(srv->status_buf_data) - offset);
+	net_buf_simple_reset(&msg);
+	status_hdr_add(&msg, rsp);
+	net_buf_simple_add(&msg, rsp->buf->len);
+
+	LOG_DBG("Sending STATUS%s message in place, TID %u data length %d",
+		rsp->compact ? " C" : "", rsp->tid, rsp->buf->len);
+
+	net_buf_simple_reset(&srv->status_msg);
+
+	_bt_mesh_vendor_stats_tx(&msg);
+
+	return bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+}
+
+/* Send a compressed STATUS if the client supports it and it's shorter. Returns -EAGAIN if
+ * nothing was sent and a plain STATUS should be sent instead.
+ */
+static int status_send_z(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			 struct bt_mesh_vendor_status *rsp)
+{
+	int caps = vnd_peer_caps_get(srv->peers, ARRAY_SIZE(srv->peers), ctx->addr);
+	struct net_buf_simple msg;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_BT_MESH_VENDOR_LZ) || caps < 0 || !(caps & BT_MESH_VENDOR_CAP_LZ) ||
+	    rsp->compact) {
+		return -EAGAIN;
+	}
+
+	if (bt_mesh_vendor_pool_buf_get(&msg)) {
+		return -EAGAIN;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_STATUS_Z);
+	net_buf_simple_add_u8(&msg, rsp->tid);
+
+	if (vnd_lz_compress_add(&msg, rsp->buf->data, rsp->buf->len)) {
+		err = -EAGAIN;
+	} else {
+		LOG_DBG("Sending compressed STATUS message, TID %u data length %d to %u",
+			rsp->tid, rsp->buf->len, msg.len);
+
+		_bt_mesh_vendor_stats_tx(&msg);
+		err = bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+		if (rsp->buf == &srv->status_msg) {
+			net_buf_simple_reset(&srv->status_msg);
+		}
+	}
+
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
+}
+
+static int status_publish(struct bt_mesh_vendor_srv *srv, struct bt_mesh_vendor_status *rsp)
+{
+	uint32_t version = bt_mesh_vendor_version(rsp->buf);
+	int err;
+
+	net_buf_simple_reset(&srv->pub_msg);
+	bt_mesh_model_msg_init(&srv->pub_msg, BT_MESH_VENDOR_OP_STATUS);
+	net_buf_simple_add_u8(&srv->pub_msg, BT_MESH_VENDOR_TID_NONE);
+	net_buf_simple_add_mem(&srv->pub_msg, rsp->buf->data, rsp->buf->len);
+
+	if (rsp->buf == &srv->status_msg) {
+		net_buf_simple_reset(&srv->status_msg);
+	}
+
+	LOG_DBG("Publishing STATUS message, data length %d",
+		srv->pub_msg.len - BT_MESH_VENDOR_STATUS_HDR_LEN);
+
+	_bt_mesh_vendor_stats_tx(&srv->pub_msg);
+
+	err = bt_mesh_model_publish(srv->model);
+	if (!err) {
+		pub_change_sent(srv, version);
+	}
+
+	return err;
+}
+
 int bt_mesh_vendor_srv_status_send(struct bt_mesh_vendor_srv *srv,
                                    struct bt_mesh_msg_ctx *ctx,
                                    struct bt_mesh_vendor_status *rsp)
 {
-	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_STATUS, srv->status_msg.len);
-	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_STATUS);
+	if (rsp->buf->len > BT_MESH_VENDOR_MSG_MAXLEN_STATUS) {
+		_bt_mesh_vendor_stats_rejected(BT_MESH_VENDOR_OP_STATUS);
+		return -EMSGSIZE;
+	}
+
+	/* Keep the response before it's sent, the stack encrypts it in place */
+	if (ctx && !rsp->compact && rsp->tid != BT_MESH_VENDOR_TID_NONE) {
+		dup_store(srv, ctx, rsp->tid, rsp->buf);
+	}
+
+	/* Fall back to a plain STATUS if compression isn't possible or doesn't help */
+	if (ctx) {
+		int err = status_send_z(srv, ctx, rsp);
+
+		if (err != -EAGAIN) {
+			return err;
+		}
+	}
+
+	if (ctx && rsp->buf == &srv->status_msg &&
+	    rsp->buf->data == &srv->status_buf_data[BT_MESH_VENDOR_STATUS_HDR_LEN]) {
+		return status_send_in_place(srv, ctx, rsp);
+	}
+
+	if (!ctx) {
+		return status_publish(srv, rsp);
+	}
+
+	struct net_buf_simple msg;
+	int err;
+
+	err = bt_mesh_vendor_pool_buf_get(&msg);
+	if (err) {
+		return err;
+	}
+
+	status_hdr_add(&msg, rsp);
 
 	if (rsp->buf->len > 0) {
 		net_buf_simple_add_mem(&msg, rsp->buf->data, rsp->buf->len);
 	}
 
-	LOG_DBG("Sending STATUS message, data length %d", rsp->buf->len);
+	LOG_DBG("Sending STATUS message, TID %u data length %d", rsp->tid, rsp->buf->len);
 
-	if (ctx) {
-		return bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
-	} else {
-		return bt_mesh_model_publish(srv->model);
-	}
+	_bt_mesh_vendor_stats_tx(&msg);
+	err = bt_mesh_model_send(srv->model, ctx, &msg, NULL, NULL);
+	bt_mesh_vendor_pool_buf_put(&msg);
+
+	return err;
 }
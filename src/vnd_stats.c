@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/shell/shell.h>
+#include "../include/vnd_stats.h"
+
+static struct k_spinlock lock;
+static struct bt_mesh_vendor_stats stats;
+
+/* Must be called with the lock held */
+static struct bt_mesh_vendor_stats_op *op_counters(uint32_t op)
+{
+	int idx = bt_mesh_vendor_stats_op_idx(op);
+
+	return idx < 0 ? NULL : &stats.op[idx];
+}
+
+static uint8_t bucket(uint32_t value)
+{
+	return value ? MIN(find_msb_set(value) - 1, BT_MESH_VENDOR_STATS_BUCKETS - 1) : 0;
+}
+
+void _bt_mesh_vendor_stats_tx(const struct net_buf_simple *msg)
+{
+	struct bt_mesh_vendor_stats_op *counters;
+	k_spinlock_key_t key;
+	uint32_t op;
+
+	/* Every vendor opcode is three bytes, the company ID is in little endian */
+	if (msg->len < 3) {
+		return;
+	}
+
+	op = (msg->data[0] << 16) | sys_get_le16(&msg->data[1]);
+
+	key = k_spin_lock(&lock);
+	counters = op_counters(op);
+	if (counters) {
+		counters->tx++;
+		counters->tx_bytes += msg->len - 3;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+void _bt_mesh_vendor_stats_rx(uint32_t op, size_t len)
+{
+	struct bt_mesh_vendor_stats_op *counters;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	counters = op_counters(op);
+	if (counters) {
+		counters->rx++;
+		counters->rx_bytes += len;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void _bt_mesh_vendor_stats_timeout(uint32_t op)
+{
+	struct bt_mesh_vendor_stats_op *counters;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	counters = op_counters(op);
+	if (counters) {
+		counters->timeouts++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void _bt_mesh_vendor_stats_rejected(uint32_t op)
+{
+	struct bt_mesh_vendor_stats_op *counters;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	counters = op_counters(op);
+	if (counters) {
+		counters->rejected++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void _bt_mesh_vendor_stats_deferred(uint32_t op)
+{
+	struct bt_mesh_vendor_stats_op *counters;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	counters = op_counters(op);
+	if (counters) {
+		counters->deferred++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void _bt_mesh_vendor_stats_hist_add(enum bt_mesh_vendor_stats_hist hist, uint32_t value)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats.hist[hist][bucket(value)]++;
+
+	k_spin_unlock(&lock, key);
+}
+
+void _bt_mesh_vendor_stats_cmd(uint8_t cmd, enum bt_mesh_vendor_cmd_result result,
+			       uint32_t time_us)
+{
+#if BT_MESH_VENDOR_STATS_CMD_COUNT
+	struct bt_mesh_vendor_stats_cmd *counters;
+	k_spinlock_key_t key;
+
+	if (cmd >= BT_MESH_VENDOR_STATS_CMD_COUNT) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	counters = &stats.cmd[cmd];
+
+	if (result == BT_MESH_VENDOR_CMD_INVALID_LEN) {
+		counters->rejected++;
+	} else {
+		counters->calls++;
+		counters->time_us += time_us;
+		if (result == BT_MESH_VENDOR_CMD_FAILED) {
+			counters->failed++;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+#endif
+}
+
+void bt_mesh_vendor_stats_get(struct bt_mesh_vendor_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = stats;
+
+	k_spin_unlock(&lock, key);
+}
+
+void bt_mesh_vendor_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(&stats, 0, sizeof(stats));
+
+	k_spin_unlock(&lock, key);
+}
+
+int bt_mesh_vendor_stats_encode(struct net_buf_simple *buf, uint8_t kind, uint8_t arg)
+{
+	uint32_t values[MAX(BT_MESH_VENDOR_STATS_BUCKETS, BT_MESH_VENDOR_STATS_OP_FIELDS)];
+	const void *src;
+	size_t count;
+	k_spinlock_key_t key;
+
+	if (kind == BT_MESH_VENDOR_STATS_KIND_HIST && arg < BT_MESH_VENDOR_STATS_HIST_COUNT) {
+		count = BT_MESH_VENDOR_STATS_BUCKETS;
+		src = stats.hist[arg];
+	} else if (kind == BT_MESH_VENDOR_STATS_KIND_OP && arg >= BT_MESH_VENDOR_STATS_OP_FIRST &&
+		   arg < BT_MESH_VENDOR_STATS_OP_FIRST + BT_MESH_VENDOR_STATS_OP_COUNT) {
+		count = BT_MESH_VENDOR_STATS_OP_FIELDS;
+		src = &stats.op[arg - BT_MESH_VENDOR_STATS_OP_FIRST];
+#if BT_MESH_VENDOR_STATS_CMD_COUNT
+	} else if (kind == BT_MESH_VENDOR_STATS_KIND_CMD && arg < BT_MESH_VENDOR_STATS_CMD_COUNT) {
+		count = BT_MESH_VENDOR_STATS_CMD_FIELDS;
+		src = &stats.cmd[arg];
+#endif
+	} else {
+		return -ENOENT;
+	}
+
+	if (net_buf_simple_tailroom(buf) < count * sizeof(uint32_t)) {
+		return -ENOBUFS;
+	}
+
+	/* Copy out under the lock, so the message is built without holding it */
+	key = k_spin_lock(&lock);
+	memcpy(values, src, count * sizeof(uint32_t));
+	k_spin_unlock(&lock, key);
+
+	for (size_t i = 0; i < count; i++) {
+		net_buf_simple_add_le32(buf, values[i]);
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_STATS_SHELL)
+static const char *const hist_names[] = {
+	[BT_MESH_VENDOR_STATS_HIST_RTT] = "Request RTT (ms)",
+	[BT_MESH_VENDOR_STATS_HIST_HANDLER] = "Handler time (us)",
+};
+
+static int cmd_stats_show(const struct shell *sh, size_t argc, char **argv)
+{
+	shell_print(sh, "Opcode       TX       RX  TX bytes  RX bytes  Timeout  EMSGSIZE  Deferred");
+
+	/* Copy one row at a time, the whole table is too large for the shell stack */
+	for (int i = 0; i < ARRAY_SIZE(stats.op); i++) {
+		struct bt_mesh_vendor_stats_op op;
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		op = stats.op[i];
+		k_spin_unlock(&lock, key);
+
+		if (!op.tx && !op.rx && !op.rejected) {
+			continue;
+		}
+
+		shell_print(sh, "0x%02x %8u %8u %9u %9u %8u %9u %9u",
+			    BT_MESH_VENDOR_STATS_OP_FIRST + i, op.tx, op.rx, op.tx_bytes,
+			    op.rx_bytes, op.timeouts, op.rejected, op.deferred);
+	}
+
+#if BT_MESH_VENDOR_STATS_CMD_COUNT
+	shell_print(sh, "Command   Calls  Rejected    Failed   Time (us)");
+
+	for (int i = 0; i < ARRAY_SIZE(stats.cmd); i++) {
+		struct bt_mesh_vendor_stats_cmd cmd;
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		cmd = stats.cmd[i];
+		k_spin_unlock(&lock, key);
+
+		if (!cmd.calls && !cmd.rejected) {
+			continue;
+		}
+
+		shell_print(sh, "%7d %7u %9u %9u %11u", i, cmd.calls, cmd.rejected, cmd.failed,
+			    cmd.time_us);
+	}
+#endif
+
+	for (int h = 0; h < BT_MESH_VENDOR_STATS_HIST_COUNT; h++) {
+		uint32_t hist[BT_MESH_VENDOR_STATS_BUCKETS];
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		memcpy(hist, stats.hist[h], sizeof(hist));
+		k_spin_unlock(&lock, key);
+
+		shell_print(sh, "%s:", hist_names[h]);
+
+		for (int i = 0; i < BT_MESH_VENDOR_STATS_BUCKETS; i++) {
+			if (!hist[i]) {
+				continue;
+			}
+
+			if (i == BT_MESH_VENDOR_STATS_BUCKETS - 1) {
+				shell_print(sh, "  %u and above: %u", 1U << i, hist[i]);
+			} else {
+				shell_print(sh, "  %u-%u: %u", i ? 1U << i : 0, (2U << i) - 1, hist[i]);
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	bt_mesh_vendor_stats_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(vnd_stats_cmds,
+	SHELL_CMD(show, NULL, "Print counters and histograms", cmd_stats_show),
+	SHELL_CMD(reset, NULL, "Reset counters and histograms", cmd_stats_reset),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(vnd_stats, &vnd_stats_cmds, "Vendor model statistics", NULL);
+#endif
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/byteorder.h>
+#include <model_utils.h>
+
+#include "mesh_stub.h"
+
+#ifndef MESH_STUB_MODEL_COUNT
+#define MESH_STUB_MODEL_COUNT 4
+#endif
+
+#ifndef MESH_STUB_QUEUE_LEN
+#define MESH_STUB_QUEUE_LEN 32
+#endif
+
+#define STUB_OP_COUNT    32
+#define STUB_DROP_COUNT  4
+/* Longest access payload, including the opcode */
+#define STUB_MSG_MAXLEN  384
+
+/* Access payload bytes of an unsegmented message, and of each segment, TransMIC included */
+#define STUB_UNSEG_LEN   15
+#define STUB_SEG_LEN     12
+#define STUB_SEG_MAX     32
+
+struct stub_msg {
+	const struct bt_mesh_send_cb *cb;
+	void *cb_data;
+	uint16_t src;
+	uint16_t dst;
+	uint16_t net_idx;
+	uint16_t app_idx;
+	uint16_t len;
+	uint8_t ttl;
+	uint8_t pdus;
+	bool lost;
+	uint8_t data[STUB_MSG_MAXLEN];
+};
+
+static struct {
+	const struct bt_mesh_model *model;
+	uint16_t addr;
+} models[MESH_STUB_MODEL_COUNT];
+
+/* Messages sent per opcode, and messages to lose, protected by lock */
+static struct {
+	uint32_t op;
+	uint32_t count;
+} tx[STUB_OP_COUNT], drops[STUB_DROP_COUNT];
+
+/* Messages and access payload bytes sent in total, protected by lock */
+static uint32_t tx_msgs;
+static uint32_t tx_bytes;
+
+/* Messages and PDUs queued or being delivered, protected by lock */
+static uint32_t pending;
+static uint32_t pending_pdus;
+static struct k_spinlock lock;
+
+/* Link model, see mesh_stub_link_set() */
+static uint32_t pdu_time_us;
+static uint32_t pdu_max;
+
+K_MSGQ_DEFINE(stub_queue, sizeof(struct stub_msg), MESH_STUB_QUEUE_LEN, 4);
+
+static int op_get(const uint8_t *data, size_t len, uint32_t *op)
+{
+	if (!len) {
+		return -EINVAL;
+	}
+
+	switch (data[0] >> 6) {
+	case 0x00:
+	case 0x01:
+		if (data[0] == 0x7f) {
+			return -EINVAL;
+		}
+
+		*op = data[0];
+		return 1;
+	case 0x02:
+		if (len < 2) {
+			return -EINVAL;
+		}
+
+		*op = sys_get_be16(data);
+		return 2;
+	default:
+		if (len < 3) {
+			return -EINVAL;
+		}
+
+		*op = (data[0] << 16) | sys_get_le16(&data[1]);
+		return 3;
+	}
+}
+
+/* Must be called with the lock held */
+static bool tx_count(uint32_t op)
+{
+	bool lost = false;
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		if (tx[i].op == op || !tx[i].count) {
+			tx[i].op = op;
+			tx[i].count++;
+			break;
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(drops); i++) {
+		if (drops[i].op == op && drops[i].count) {
+			drops[i].count--;
+			lost = true;
+			break;
+		}
+	}
+
+	return lost;
+}
+
+static uint16_t model_addr(const struct bt_mesh_model *model)
+{
+	for (int i = 0; i < ARRAY_SIZE(models); i++) {
+		if (models[i].model == model) {
+			return models[i].addr;
+		}
+	}
+
+	return BT_MESH_ADDR_UNASSIGNED;
+}
+
+/* Number of network PDUs the message takes on the air */
+static uint8_t pdu_count(size_t len, bool rel)
+{
+	len += BT_MESH_MIC_SHORT;
+
+	return len <= STUB_UNSEG_LEN && !rel ? 1 : DIV_ROUND_UP(len, STUB_SEG_LEN);
+}
+
+static int stub_send(const struct bt_mesh_model *model, uint16_t net_idx, uint16_t app_idx,
+		     uint16_t dst, uint8_t ttl, bool rel, const struct net_buf_simple *buf,
+		     const struct bt_mesh_send_cb *cb, void *cb_data)
+{
+	static struct stub_msg msg;
+	k_spinlock_key_t key;
+	uint8_t pdus = pdu_count(buf->len, rel);
+	uint32_t op;
+	int err;
+
+	if (buf->len > sizeof(msg.data) || pdus > STUB_SEG_MAX ||
+	    op_get(buf->data, buf->len, &op) < 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Like the advertising buffers, the link only holds so many PDUs */
+	if (pdu_max && pending_pdus + pdus > pdu_max) {
+		k_spin_unlock(&lock, key);
+		return -ENOBUFS;
+	}
+
+	msg.cb = cb;
+	msg.cb_data = cb_data;
+	msg.src = model_addr(model);
+	msg.dst = dst;
+	msg.net_idx = net_idx;
+	msg.app_idx = app_idx;
+	msg.ttl = ttl;
+	msg.pdus = pdus;
+	msg.len = buf->len;
+	msg.lost = tx_count(op);
+	tx_msgs++;
+	tx_bytes += buf->len;
+	memcpy(msg.data, buf->data, buf->len);
+
+	err = k_msgq_put(&stub_queue, &msg, K_NO_WAIT);
+	if (!err) {
+		pending++;
+		pending_pdus += pdus;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return err ? -ENOBUFS : 0;
+}
+
+static const struct bt_mesh_model_op *op_find(const struct bt_mesh_model *model, uint32_t op)
+{
+	for (const struct bt_mesh_model_op *entry = model->op; entry && entry->func; entry++) {
+		if (entry->opcode == op) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void stub_deliver(const struct stub_msg *msg)
+{
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = msg->net_idx,
+		.app_idx = msg->app_idx,
+		.addr = msg->src,
+		.recv_dst = msg->dst,
+		.recv_ttl = msg->ttl,
+		.send_ttl = BT_MESH_TTL_DEFAULT,
+	};
+	const struct bt_mesh_model_op *entry;
+	struct net_buf_simple buf;
+	uint32_t op;
+	int len;
+
+	len = op_get(msg->data, msg->len, &op);
+	if (len < 0) {
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(models); i++) {
+		if (!models[i].model ||
+		    (BT_MESH_ADDR_IS_UNICAST(msg->dst) && models[i].addr != msg->dst)) {
+			continue;
+		}
+
+		entry = op_find(models[i].model, op);
+		if (!entry) {
+			continue;
+		}
+
+		/* Every model gets its own copy, as handlers pull from the buffer */
+		net_buf_simple_init_with_data(&buf, (void *)&msg->data[len], msg->len - len);
+
+		if ((entry->len >= 0 && buf.len < entry->len) ||
+		    (entry->len < 0 && buf.len != -entry->len)) {
+			continue;
+		}
+
+		(void)entry->func(models[i].model, &ctx, &buf);
+	}
+}
+
+static void stub_rx_thread(void *p1, void *p2, void *p3)
+{
+	static struct stub_msg msg;
+	k_spinlock_key_t key;
+
+	while (1) {
+		uint32_t airtime;
+
+		k_msgq_get(&stub_queue, &msg, K_FOREVER);
+
+		/* One message on the air at a time, for as long as its PDUs take */
+		key = k_spin_lock(&lock);
+		airtime = msg.pdus * pdu_time_us;
+		k_spin_unlock(&lock, key);
+
+		if (msg.cb && msg.cb->start) {
+			msg.cb->start(airtime / USEC_PER_MSEC, 0, msg.cb_data);
+		}
+
+		if (airtime) {
+			k_sleep(K_USEC(airtime));
+		}
+
+		if (msg.cb && msg.cb->end) {
+			msg.cb->end(0, msg.cb_data);
+		}
+
+		if (!msg.lost) {
+			stub_deliver(&msg);
+		}
+
+		key = k_spin_lock(&lock);
+		pending--;
+		pending_pdus -= msg.pdus;
+		k_spin_unlock(&lock, key);
+	}
+}
+
+K_THREAD_DEFINE(stub_rx, 4096, stub_rx_thread, NULL, NULL, NULL, K_PRIO_COOP(7), 0, 0);
+
+int bt_mesh_model_send(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		       struct net_buf_simple *msg, const struct bt_mesh_send_cb *cb,
+		       void *cb_data)
+{
+	return stub_send(model, ctx->net_idx, ctx->app_idx, ctx->addr, ctx->send_ttl,
+			 ctx->send_rel, msg, cb, cb_data);
+}
+
+int bt_mesh_model_publish(const struct bt_mesh_model *model)
+{
+	struct bt_mesh_model_pub *pub = model->pub;
+
+	if (!pub || pub->addr == BT_MESH_ADDR_UNASSIGNED) {
+		return -EADDRNOTAVAIL;
+	}
+
+	if (!pub->msg || !pub->msg->len) {
+		return -EINVAL;
+	}
+
+	return stub_send(model, 0, pub->key, pub->addr, pub->ttl, pub->send_rel, pub->msg, NULL,
+			 NULL);
+}
+
+int32_t model_ackd_timeout_get(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	/* Time for the longest request and response on the air, on top of the fixed timeout */
+	int32_t timeout = MESH_STUB_ACK_TIMEOUT + 2 * STUB_SEG_MAX * pdu_time_us / USEC_PER_MSEC;
+
+	k_spin_unlock(&lock, key);
+
+	return timeout;
+}
+
+int mesh_stub_model_add(const struct bt_mesh_model *model, uint16_t addr)
+{
+	for (int i = 0; i < ARRAY_SIZE(models); i++) {
+		if (!models[i].model) {
+			models[i].model = model;
+			models[i].addr = addr;
+
+			return model->cb && model->cb->init ? model->cb->init(model) : 0;
+		}
+	}
+
+	return -ENOMEM;
+}
+
+void mesh_stub_flush(void)
+{
+	while (1) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		uint32_t count = pending;
+
+		k_spin_unlock(&lock, key);
+
+		if (!count) {
+			return;
+		}
+
+		k_sleep(K_MSEC(1));
+	}
+}
+
+void mesh_stub_reset(void)
+{
+	static struct stub_msg msg;
+	k_spinlock_key_t key;
+
+	for (int i = 0; i < ARRAY_SIZE(models); i++) {
+		if (models[i].model && models[i].model->cb && models[i].model->cb->reset) {
+			models[i].model->cb->reset(models[i].model);
+		}
+	}
+
+	/* Messages still queued are lost, and the one being delivered is let through */
+	key = k_spin_lock(&lock);
+
+	while (!k_msgq_get(&stub_queue, &msg, K_NO_WAIT)) {
+		pending--;
+		pending_pdus -= msg.pdus;
+	}
+
+	memset(drops, 0, sizeof(drops));
+	k_spin_unlock(&lock, key);
+
+	mesh_stub_flush();
+
+	key = k_spin_lock(&lock);
+	memset(tx, 0, sizeof(tx));
+	tx_msgs = 0;
+	tx_bytes = 0;
+	k_spin_unlock(&lock, key);
+}
+
+void mesh_stub_model_clear(void)
+{
+	mesh_stub_reset();
+
+	memset(models, 0, sizeof(models));
+}
+
+void mesh_stub_link_set(uint32_t pdu_time, uint32_t max)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	pdu_time_us = pdu_time;
+	pdu_max = max;
+
+	k_spin_unlock(&lock, key);
+}
+
+void mesh_stub_drop(uint32_t op, uint32_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < ARRAY_SIZE(drops); i++) {
+		if (drops[i].op == op || !drops[i].count) {
+			drops[i].op = op;
+			drops[i].count = count;
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+uint32_t mesh_stub_tx_count(uint32_t op)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		if (tx[i].op == op) {
+			count = tx[i].count;
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+
+uint32_t mesh_stub_tx_total(uint32_t *bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t msgs = tx_msgs;
+
+	*bytes = tx_bytes;
+
+	k_spin_unlock(&lock, key);
+
+	return msgs;
+}
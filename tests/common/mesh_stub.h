@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef MESH_STUB_H__
+#define MESH_STUB_H__
+
+#include <zephyr/bluetooth/mesh.h>
+
+/* Access layer stub. Messages the models send are delivered to the models registered at the
+ * destination address from a thread of their own, like the mesh stack's receive thread, so
+ * blocking requests can wait for their response. Group addresses reach every model.
+ *
+ * Up to MESH_STUB_MODEL_COUNT models can be registered, and MESH_STUB_QUEUE_LEN messages
+ * queued. Define them to change the defaults of 4 and 32.
+ */
+
+/** Timeout the models get for acknowledged messages in milliseconds, with no airtime */
+#define MESH_STUB_ACK_TIMEOUT 200
+
+/* Register a model at a unicast address and initialize it */
+int mesh_stub_model_add(const struct bt_mesh_model *model, uint16_t addr);
+
+/* Reset the registered models and forget all messages, like a node reset */
+void mesh_stub_reset(void);
+
+/* Reset and unregister every model */
+void mesh_stub_model_clear(void);
+
+/* Model a shared link. Messages are delivered one at a time, each after pdu_time
+ * microseconds per network PDU, where segmented messages take one PDU per 12 bytes. Sending
+ * fails with -ENOBUFS if the messages queued would take more than max PDUs, or 0 for no
+ * limit. The ack timeout of the models grows by the time of 64 PDUs. Defaults to 0 and 0,
+ * delivering messages as soon as the receive thread runs.
+ */
+void mesh_stub_link_set(uint32_t pdu_time, uint32_t max);
+
+/* Lose the next count messages with the given opcode. They're still counted as sent. */
+void mesh_stub_drop(uint32_t op, uint32_t count);
+
+/* Number of messages with the given opcode sent since the last reset */
+uint32_t mesh_stub_tx_count(uint32_t op);
+
+/* Number of messages sent since the last reset, and their access payload bytes, opcodes
+ * included
+ */
+uint32_t mesh_stub_tx_total(uint32_t *bytes);
+
+/* Wait until every message sent has been delivered or lost */
+void mesh_stub_flush(void);
+
+#endif /* MESH_STUB_H__ */
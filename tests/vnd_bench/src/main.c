@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/util.h>
+
+#include "vnd_cli.h"
+#include "vnd_srv.h"
+#include "vnd_bench.h"
+#include "mesh_stub.h"
+
+#define CLI_ADDR       0x0001
+#define SRV_ADDR_FIRST 0x0002
+#define GROUP_ADDR     0xc000
+#define NODE_MAX       50
+#define TTL            3
+
+/* Link model: a network PDU with the default network transmit of three advertisements 20 ms
+ * apart, and as many PDUs in flight as the advertising buffers of the sample hold, with room
+ * for the segments of the largest message
+ */
+#define PDU_TIME_US 10000
+#define PDU_MAX     64
+
+/* Scheduling slack on top of the airtime of a request and its response */
+#define RTT_SLACK_MS 20
+
+/* The servers answer with the TID only, so the response is a single PDU */
+static int srv_set(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+		   const struct bt_mesh_vendor_set *set, struct bt_mesh_vendor_status *rsp)
+{
+	return 0;
+}
+
+static int srv_get(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+		   const struct bt_mesh_vendor_get *get, struct bt_mesh_vendor_status *rsp)
+{
+	return 0;
+}
+
+static const struct bt_mesh_vendor_srv_handlers srv_handlers = {
+	.set = srv_set,
+	.get = srv_get,
+};
+
+#define SRV_INIT(i, ...)  BT_MESH_VENDOR_SRV_INIT(&srv_handlers)
+#define SRV_MODEL(i, ...) BT_MESH_MODEL_VND_SRV(&srvs[i], &srv_handlers)
+
+static struct bt_mesh_vendor_cli cli = BT_MESH_VND_CLI_INIT(NULL);
+static struct bt_mesh_vendor_srv srvs[NODE_MAX] = { LISTIFY(NODE_MAX, SRV_INIT, (,)) };
+
+static const struct bt_mesh_model cli_models[] = {
+	BT_MESH_MODEL_VND_CLI(&cli),
+};
+
+static const struct bt_mesh_model srv_models[NODE_MAX] = { LISTIFY(NODE_MAX, SRV_MODEL, (,)) };
+
+/* Mostly incompressible, like the payload of the shell command */
+static uint8_t payload[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+
+/* Airtime of a unicast SET of the given size and its response, in milliseconds */
+static uint32_t rtt_max(uint16_t size)
+{
+	size_t set_len = BT_MESH_MODEL_OP_LEN(BT_MESH_VENDOR_OP_SET) + BT_MESH_VENDOR_TID_LEN +
+			 size + BT_MESH_MIC_SHORT;
+	uint32_t pdus = (set_len <= 15 ? 1 : DIV_ROUND_UP(set_len, 12)) + 1;
+
+	return pdus * PDU_TIME_US / USEC_PER_MSEC + RTT_SLACK_MS;
+}
+
+static void row_print(uint32_t nodes, struct bt_mesh_msg_ctx *ctx, bool ack, uint16_t size,
+		      const struct vnd_bench_result *res)
+{
+	char row[80];
+
+	vnd_bench_csv_row(row, sizeof(row), ctx, ack, size, res);
+	TC_PRINT("%u,%s\n", nodes, row);
+}
+
+/* Provision the client and the given number of servers, and run the sweep against the last
+ * server and against the group of all of them. Unicast steps must deliver every message, and
+ * acknowledged ones within the airtime of the request and response. Group steps share the
+ * link with a response from every server, and are only reported.
+ */
+static void sweep(uint32_t nodes)
+{
+	const uint16_t dsts[] = { SRV_ADDR_FIRST + nodes - 1, GROUP_ADDR };
+
+	mesh_stub_model_clear();
+	mesh_stub_link_set(PDU_TIME_US, PDU_MAX);
+
+	zassert_ok(mesh_stub_model_add(&cli_models[0], CLI_ADDR));
+
+	for (int i = 0; i < nodes; i++) {
+		zassert_ok(mesh_stub_model_add(&srv_models[i], SRV_ADDR_FIRST + i));
+	}
+
+	for (int d = 0; d < ARRAY_SIZE(dsts); d++) {
+		for (int s = 0; s < ARRAY_SIZE(vnd_bench_sizes); s++) {
+			uint16_t size = vnd_bench_sizes[s];
+			struct bt_mesh_msg_ctx ctx = {
+				.app_idx = 0,
+				.addr = dsts[d],
+				.send_ttl = TTL,
+			};
+			struct bt_mesh_vendor_iov iov = {
+				.data = payload,
+				.len = size,
+			};
+			struct bt_mesh_vendor_set set = {
+				.iov = &iov,
+				.iov_cnt = 1,
+			};
+			bool unicast = BT_MESH_ADDR_IS_UNICAST(ctx.addr);
+			struct vnd_bench_result res = { 0 };
+
+			/* Every step starts on an idle link */
+			mesh_stub_flush();
+			vnd_bench_ack(&cli, &ctx, &set, &res);
+			row_print(nodes, &ctx, true, size, &res);
+
+			if (unicast) {
+				zassert_equal(res.delivered, res.sent, "ack %u bytes", size);
+				zassert_true(res.p99 <= rtt_max(size), "ack %u bytes, p99 %u ms",
+					     size, res.p99);
+			}
+
+			mesh_stub_flush();
+			vnd_bench_unack(&cli, &ctx, &set, &res);
+			row_print(nodes, &ctx, false, size, &res);
+
+			if (unicast) {
+				zassert_equal(res.sent, CONFIG_BT_MESH_VENDOR_BENCH_COUNT);
+				zassert_equal(res.delivered, res.sent, "unack %u bytes", size);
+			}
+		}
+	}
+}
+
+ZTEST(vnd_bench, test_nodes_2)
+{
+	sweep(2);
+}
+
+ZTEST(vnd_bench, test_nodes_10)
+{
+	sweep(10);
+}
+
+ZTEST(vnd_bench, test_nodes_50)
+{
+	sweep(NODE_MAX);
+}
+
+static void *vnd_bench_setup(void)
+{
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (i * 151 + 17) ^ (i >> 3);
+	}
+
+	TC_PRINT("nodes,%s\n", VND_BENCH_CSV_HEADER);
+
+	return NULL;
+}
+
+ZTEST_SUITE(vnd_bench, NULL, vnd_bench_setup, NULL, NULL, NULL);
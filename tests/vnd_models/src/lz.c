@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "vnd_common.h"
+#include "vnd_lz.h"
+
+/* The static dictionary, which other nodes must share */
+#define DICT "Hello World- Response OK- 0123456789ABCDEF"
+#define DICT_LEN (sizeof(DICT) - 1)
+
+#define MATCH_MAX 18
+
+/* Room for a payload of literals only, with a flag byte per eight of them */
+static uint8_t packed[BT_MESH_VENDOR_MSG_MAXLEN_SET +
+		      DIV_ROUND_UP(BT_MESH_VENDOR_MSG_MAXLEN_SET, 8)];
+static uint8_t unpacked[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+
+/* Returns the compressed length */
+static int round_trip(const uint8_t *data, size_t len, size_t packed_max)
+{
+	int packed_len;
+	int n;
+
+	packed_len = vnd_lz_compress(data, len, packed, sizeof(packed));
+	zassert_true(packed_len > 0, "err %d", packed_len);
+	zassert_true(packed_len <= packed_max, "%d bytes", packed_len);
+
+	/* The output buffer is exactly as long as the payload */
+	n = vnd_lz_decompress(packed, packed_len, unpacked, len);
+	zassert_equal(n, len);
+	zassert_mem_equal(unpacked, data, len);
+
+	return packed_len;
+}
+
+static int unpack(const uint8_t *in, size_t len, size_t max)
+{
+	return vnd_lz_decompress(in, len, unpacked, max);
+}
+
+ZTEST(vnd_lz, test_dict)
+{
+	const uint8_t data[] = "Response OK- " DICT;
+
+	/* Only matches: 55 bytes in four matches of up to 18 bytes, with one flag byte */
+	round_trip(data, sizeof(data) - 1, 1 + 4 * 2);
+}
+
+ZTEST(vnd_lz, test_dict_edge)
+{
+	/* The distance reaches the first dictionary byte */
+	const uint8_t first[] = { 0x01, DICT_LEN - 1, 0x00 };
+	/* The distance reaches one byte before the dictionary */
+	const uint8_t before[] = { 0x01, DICT_LEN, 0x00 };
+
+	zassert_equal(unpack(first, sizeof(first), sizeof(unpacked)), 3);
+	zassert_mem_equal(unpacked, "Hel", 3);
+
+	zassert_equal(unpack(before, sizeof(before), sizeof(unpacked)), -EINVAL);
+}
+
+ZTEST(vnd_lz, test_overlap)
+{
+	/* Two literals, then a match of 18 bytes at distance 2, which overlaps its own output */
+	const uint8_t in[] = { 0x04, 'a', 'b', 0x01, 0x0f };
+	uint8_t data[2 + MATCH_MAX];
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i & 1 ? 'b' : 'a';
+	}
+
+	zassert_equal(unpack(in, sizeof(in), sizeof(data)), sizeof(data));
+	zassert_mem_equal(unpacked, data, sizeof(data));
+
+	/* The compressor finds the same overlapping match */
+	round_trip(data, sizeof(data), sizeof(in));
+}
+
+ZTEST(vnd_lz, test_max_len)
+{
+	static uint8_t data[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+	int n;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = "0123456789ABCDEF"[(i * 7) % 16];
+	}
+
+	/* After 16 literals, every match is as long as a match can be */
+	n = round_trip(data, sizeof(data), sizeof(data) / 4);
+
+	/* One byte short of room for the output */
+	zassert_equal(unpack(packed, n, sizeof(data) - 1), -EINVAL);
+}
+
+ZTEST(vnd_lz, test_incompressible)
+{
+	static uint8_t data[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+	uint32_t x = 1;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		x = x * 1103515245 + 12345;
+		data[i] = x >> 24;
+	}
+
+	zassert_equal(vnd_lz_compress(data, sizeof(data), packed, sizeof(data) - 1), -ENOSPC);
+
+	/* Literals only grow the payload, but still survive the round trip */
+	round_trip(data, sizeof(data), sizeof(packed));
+}
+
+ZTEST(vnd_lz, test_truncated)
+{
+	/* Match with its second byte missing */
+	const uint8_t half[] = { 0x01, 0x00 };
+	/* Match flagged in a group that ends before it */
+	const uint8_t missing[] = { 0x02, 'a' };
+	/* Flag byte of a group with no tokens */
+	const uint8_t empty[] = { 0x01 };
+
+	zassert_equal(unpack(half, sizeof(half), sizeof(unpacked)), -EINVAL);
+	zassert_equal(unpack(missing, sizeof(missing), sizeof(unpacked)), -EINVAL);
+	zassert_equal(unpack(empty, sizeof(empty), sizeof(unpacked)), -EINVAL);
+}
+
+ZTEST(vnd_lz, test_overflow)
+{
+	const uint8_t literals[] = { 0x00, 'a', 'b', 'c' };
+	/* A literal, then a match of 4 bytes at distance 1 */
+	const uint8_t match[] = { 0x02, 'a', 0x00, 0x01 };
+
+	zassert_equal(unpack(literals, sizeof(literals), 3), 3);
+	zassert_equal(unpack(literals, sizeof(literals), 2), -EINVAL);
+
+	zassert_equal(unpack(match, sizeof(match), 5), 5);
+	zassert_mem_equal(unpacked, "aaaaa", 5);
+	zassert_equal(unpack(match, sizeof(match), 4), -EINVAL);
+}
+
+ZTEST_SUITE(vnd_lz, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,664 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "vnd_cli.h"
+#include "vnd_srv.h"
+#include "mesh_stub.h"
+
+#define CLI_ADDR 0x0001
+#define SRV_ADDR 0x0002
+
+/* Length of the SET response, short enough for the duplicate cache to keep */
+#define SET_RSP_LEN 8
+
+#define CMD_ECHO 1
+
+#define KV_LEVEL 0x01
+#define KV_SERIAL 0x02
+
+static struct {
+	uint8_t data[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+	size_t len;
+	uint32_t sets;
+	uint32_t cmds;
+	uint32_t kv_changes;
+} srv_state;
+
+static struct {
+	uint8_t key;
+	uint8_t value[4];
+	size_t len;
+	uint32_t count;
+} kv_notified;
+
+static uint8_t kv_level;
+static uint32_t kv_serial = 0x12345678;
+
+NET_BUF_SIMPLE_DEFINE_STATIC(rsp_buf, BT_MESH_VENDOR_MSG_MAXLEN_STATUS);
+
+static int srv_set(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+		   const struct bt_mesh_vendor_set *set, struct bt_mesh_vendor_status *rsp)
+{
+	memcpy(srv_state.data, set->buf->data, set->buf->len);
+	srv_state.len = set->buf->len;
+	srv_state.sets++;
+
+	net_buf_simple_add_mem(rsp->buf, srv_state.data, MIN(srv_state.len, SET_RSP_LEN));
+
+	return 0;
+}
+
+static int srv_get(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+		   const struct bt_mesh_vendor_get *get, struct bt_mesh_vendor_status *rsp)
+{
+	size_t len = get ? MIN(get->length, srv_state.len) : srv_state.len;
+
+	net_buf_simple_add_mem(rsp->buf, srv_state.data, len);
+
+	return 0;
+}
+
+static int srv_cmd_echo(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			struct net_buf_simple *params, struct net_buf_simple *rsp)
+{
+	net_buf_simple_add_mem(rsp, params->data, params->len);
+	srv_state.cmds++;
+
+	return 0;
+}
+
+static void srv_kv_changed(struct bt_mesh_vendor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+			   const struct bt_mesh_vendor_kv *kv)
+{
+	srv_state.kv_changes++;
+}
+
+static const struct bt_mesh_vendor_cmd srv_cmds[] = {
+	[CMD_ECHO] = BT_MESH_VENDOR_CMD(srv_cmd_echo, 0, BT_MESH_VENDOR_CMD_RSP_MAXLEN),
+};
+
+static const struct bt_mesh_vendor_kv srv_kvs[] = {
+	BT_MESH_VENDOR_KV(KV_LEVEL, kv_level),
+	BT_MESH_VENDOR_KV_RO(KV_SERIAL, kv_serial),
+};
+
+static const struct bt_mesh_vendor_srv_handlers srv_handlers = {
+	.set = srv_set,
+	.get = srv_get,
+	.kv_changed = srv_kv_changed,
+	.kvs = srv_kvs,
+	.kv_count = ARRAY_SIZE(srv_kvs),
+	.cmds = srv_cmds,
+	.cmd_count = ARRAY_SIZE(srv_cmds),
+};
+
+static struct bt_mesh_vendor_cli cli = BT_MESH_VND_CLI_INIT(NULL);
+static struct bt_mesh_vendor_srv srv = BT_MESH_VENDOR_SRV_INIT(&srv_handlers);
+
+static const struct bt_mesh_model cli_models[] = {
+	BT_MESH_MODEL_VND_CLI(&cli),
+};
+
+static const struct bt_mesh_model srv_models[] = {
+	BT_MESH_MODEL_VND_SRV(&srv, &srv_handlers),
+};
+
+static void cli_kv_notify(struct bt_mesh_vendor_cli *cli, struct bt_mesh_msg_ctx *ctx,
+			  uint8_t key, const void *value, size_t len)
+{
+	kv_notified.key = key;
+	kv_notified.len = MIN(len, sizeof(kv_notified.value));
+	memcpy(kv_notified.value, value, kv_notified.len);
+	kv_notified.count++;
+}
+
+/* Random bytes don't compress, so payloads are sent as they are */
+static void payload_fill(uint8_t *data, size_t len, uint32_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = seed >> 16;
+	}
+}
+
+static int cli_set(const uint8_t *data, size_t len, struct bt_mesh_vendor_status *rsp)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	struct bt_mesh_vendor_iov iov = {
+		.data = data,
+		.len = len,
+	};
+	struct bt_mesh_vendor_set msg = {
+		.iov = &iov,
+		.iov_cnt = 1,
+	};
+
+	net_buf_simple_reset(&rsp_buf);
+	rsp->buf = &rsp_buf;
+
+	return bt_mesh_vendor_cli_set(&cli, &ctx, &msg, rsp);
+}
+
+static uint32_t sets_sent(void)
+{
+	return mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET) +
+	       mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_Z);
+}
+
+/* Each blocking request returns with its response. The calls used to wait for the
+ * completion callback a second time, and hung after the first response.
+ */
+ZTEST(vnd_models, test_set_get)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	struct bt_mesh_vendor_get get = { .length = 10 };
+	struct bt_mesh_vendor_status rsp;
+	uint8_t payload[20];
+
+	for (int i = 0; i < 3; i++) {
+		payload_fill(payload, sizeof(payload), i);
+
+		zassert_ok(cli_set(payload, sizeof(payload), &rsp));
+		zassert_equal(rsp_buf.len, SET_RSP_LEN);
+		zassert_mem_equal(rsp_buf.data, payload, SET_RSP_LEN);
+		zassert_equal(srv_state.len, sizeof(payload));
+		zassert_mem_equal(srv_state.data, payload, sizeof(payload));
+	}
+
+	net_buf_simple_reset(&rsp_buf);
+	zassert_ok(bt_mesh_vendor_cli_get(&cli, &ctx, &get, &rsp));
+	zassert_equal(rsp_buf.len, get.length);
+	zassert_mem_equal(rsp_buf.data, payload, get.length);
+
+	zassert_equal(srv_state.sets, 3);
+	zassert_equal(sets_sent(), 3);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_STATUS), 4);
+}
+
+ZTEST(vnd_models, test_set_unack)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	uint8_t payload[12];
+	struct bt_mesh_vendor_iov iov = {
+		.data = payload,
+		.len = sizeof(payload),
+	};
+	struct bt_mesh_vendor_set msg = {
+		.iov = &iov,
+		.iov_cnt = 1,
+	};
+
+	payload_fill(payload, sizeof(payload), 1);
+
+	zassert_ok(bt_mesh_vendor_cli_set_unack(&cli, &ctx, &msg));
+	mesh_stub_flush();
+
+	zassert_equal(srv_state.sets, 1);
+	zassert_mem_equal(srv_state.data, payload, sizeof(payload));
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_STATUS), 0);
+}
+
+ZTEST(vnd_models, test_set_compact)
+{
+	struct bt_mesh_vendor_status rsp;
+	uint8_t payload[4] = { 1, 2, 3, 4 };
+
+	zassert_ok(cli_set(payload, sizeof(payload), &rsp));
+	zassert_equal(rsp_buf.len, sizeof(payload));
+	zassert_mem_equal(rsp_buf.data, payload, sizeof(payload));
+
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_C), 1);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_STATUS_C), 1);
+	zassert_equal(sets_sent(), 0);
+}
+
+/* A compact SET longer than the client ever sends is dropped */
+ZTEST(vnd_models, test_set_compact_long)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_VENDOR_OP_SET_C, BT_MESH_VENDOR_MSG_MAXLEN_SET_C + 1);
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_VENDOR_OP_SET_C);
+	memset(net_buf_simple_add(&msg, BT_MESH_VENDOR_MSG_MAXLEN_SET_C + 1), 0,
+	       BT_MESH_VENDOR_MSG_MAXLEN_SET_C + 1);
+	zassert_ok(bt_mesh_model_send(&cli_models[0], &ctx, &msg, NULL, NULL));
+	mesh_stub_flush();
+
+	zassert_equal(srv_state.sets, 0);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_STATUS_C), 0);
+}
+
+/* A compact SET is never sent again, and the server gets regular SETs until a late
+ * compact STATUS can no longer arrive.
+ */
+ZTEST(vnd_models, test_set_compact_lost)
+{
+	struct bt_mesh_vendor_status rsp;
+	uint8_t payload[4] = { 1, 2, 3, 4 };
+
+	mesh_stub_drop(BT_MESH_VENDOR_OP_STATUS_C, 1);
+
+	zassert_equal(cli_set(payload, sizeof(payload), &rsp), -ETIMEDOUT);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_C), 1);
+	zassert_equal(srv_state.sets, 1);
+
+	zassert_ok(cli_set(payload, sizeof(payload), &rsp));
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_C), 1);
+	zassert_equal(sets_sent(), 1);
+	zassert_mem_equal(rsp_buf.data, payload, sizeof(payload));
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT) && defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+/* A SET whose STATUS is lost is sent again, and the server answers from its duplicate
+ * cache instead of applying it twice.
+ */
+ZTEST(vnd_models, test_set_retry)
+{
+	struct bt_mesh_vendor_status rsp;
+	uint8_t payload[20];
+
+	payload_fill(payload, sizeof(payload), 2);
+	mesh_stub_drop(BT_MESH_VENDOR_OP_STATUS, 1);
+
+	zassert_ok(cli_set(payload, sizeof(payload), &rsp));
+	zassert_mem_equal(rsp_buf.data, payload, SET_RSP_LEN);
+
+	zassert_equal(sets_sent(), 2);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_STATUS), 2);
+	zassert_equal(srv_state.sets, 1);
+}
+
+ZTEST(vnd_models, test_set_timeout)
+{
+	struct bt_mesh_vendor_status rsp;
+	uint8_t payload[20];
+
+	payload_fill(payload, sizeof(payload), 3);
+	mesh_stub_drop(BT_MESH_VENDOR_OP_STATUS, UINT32_MAX);
+
+	zassert_equal(cli_set(payload, sizeof(payload), &rsp), -ETIMEDOUT);
+	zassert_equal(sets_sent(), 1 + CONFIG_BT_MESH_VENDOR_CLI_RETRIES);
+	zassert_equal(srv_state.sets, 1);
+
+	/* Nothing is left behind for the next request */
+	mesh_stub_drop(BT_MESH_VENDOR_OP_STATUS, 0);
+	payload_fill(payload, sizeof(payload), 4);
+
+	zassert_ok(cli_set(payload, sizeof(payload), &rsp));
+	zassert_mem_equal(rsp_buf.data, payload, SET_RSP_LEN);
+	zassert_equal(srv_state.sets, 2);
+}
+#endif
+
+ZTEST(vnd_models, test_get_cond)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	struct bt_mesh_vendor_status rsp = { .buf = &rsp_buf };
+	uint8_t payload[20];
+	uint32_t version = 0;
+
+	payload_fill(payload, sizeof(payload), 5);
+	zassert_ok(cli_set(payload, sizeof(payload), &rsp));
+
+	net_buf_simple_reset(&rsp_buf);
+	zassert_ok(bt_mesh_vendor_cli_get_cond(&cli, &ctx, NULL, &version, &rsp));
+	zassert_equal(rsp_buf.len, sizeof(payload));
+	zassert_mem_equal(rsp_buf.data, payload, sizeof(payload));
+	zassert_not_equal(version, 0);
+
+	zassert_equal(bt_mesh_vendor_cli_get_cond(&cli, &ctx, NULL, &version, &rsp), -EALREADY);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_NOT_MODIFIED), 1);
+}
+
+/* Payload sizes the cost of the models is measured at, as in the loopback benchmark */
+static const uint16_t perf_sizes[] = {
+	0, 8, 11, 32, 64, 128, 256, BT_MESH_VENDOR_MSG_MAXLEN_SET,
+};
+
+struct perf_step {
+	uint32_t start;
+	uint32_t msgs;
+	uint32_t bytes;
+};
+
+static void perf_start(struct perf_step *step)
+{
+	step->msgs = mesh_stub_tx_total(&step->bytes);
+	step->start = k_cycle_get_32();
+}
+
+/* Print the cost of one exchange, and check that it took a request and a response of no more
+ * than max_bytes together
+ */
+static void perf_end(const struct perf_step *step, const char *op, size_t size, size_t max_bytes)
+{
+	uint32_t cycles = k_cycle_get_32() - step->start;
+	uint32_t bytes;
+	uint32_t msgs;
+
+	mesh_stub_flush();
+	msgs = mesh_stub_tx_total(&bytes) - step->msgs;
+	bytes -= step->bytes;
+
+	TC_PRINT("%s,%zu,%u,%u,%u\n", op, size, cycles, k_cyc_to_us_floor32(cycles), bytes);
+
+	zassert_equal(msgs, 2, "%s of %zu bytes", op, size);
+	zassert_true(bytes <= max_bytes, "%s of %zu bytes took %u bytes", op, size, bytes);
+}
+
+/* Cost of a blocking SET and GET at every payload size. The cycles are only printed, as they
+ * depend on the build and the board. The message bytes are the same on every run, so they're
+ * checked: no request or response may carry more than its opcode, TID and data.
+ */
+ZTEST(vnd_models, test_perf)
+{
+	static uint8_t payload[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	struct bt_mesh_vendor_status rsp;
+	struct perf_step step;
+
+	TC_PRINT("op,size,cycles,us,msg_bytes\n");
+
+	for (int i = 0; i < ARRAY_SIZE(perf_sizes); i++) {
+		size_t size = perf_sizes[i];
+		struct bt_mesh_vendor_get get = { .length = size };
+
+		payload_fill(payload, size, i);
+
+		perf_start(&step);
+		zassert_ok(cli_set(payload, size, &rsp));
+		perf_end(&step, "set", size,
+			 BT_MESH_MODEL_OP_LEN(BT_MESH_VENDOR_OP_SET) + BT_MESH_VENDOR_TID_LEN + size +
+			 BT_MESH_MODEL_OP_LEN(BT_MESH_VENDOR_OP_STATUS) + BT_MESH_VENDOR_TID_LEN +
+			 MIN(size, SET_RSP_LEN));
+
+		net_buf_simple_reset(&rsp_buf);
+		perf_start(&step);
+		zassert_ok(bt_mesh_vendor_cli_get(&cli, &ctx, &get, &rsp));
+		perf_end(&step, "get", size,
+			 BT_MESH_MODEL_OP_LEN(BT_MESH_VENDOR_OP_GET) + BT_MESH_VENDOR_MSG_MAXLEN_GET +
+			 BT_MESH_MODEL_OP_LEN(BT_MESH_VENDOR_OP_STATUS) + BT_MESH_VENDOR_TID_LEN +
+			 size);
+		zassert_equal(rsp_buf.len, size);
+		zassert_mem_equal(rsp_buf.data, payload, size);
+	}
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_DELTA)
+static int cli_set_delta(const uint8_t *data, size_t len, struct bt_mesh_vendor_status *rsp)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+
+	net_buf_simple_reset(&rsp_buf);
+	rsp->buf = &rsp_buf;
+
+	return bt_mesh_vendor_cli_set_delta(&cli, &ctx, data, len, rsp);
+}
+
+ZTEST(vnd_models, test_set_delta)
+{
+	struct bt_mesh_vendor_status rsp;
+	uint8_t payload[48];
+
+	payload_fill(payload, sizeof(payload), 6);
+
+	/* The first SET has no base, and the second one is sent as a delta to it */
+	zassert_ok(cli_set_delta(payload, sizeof(payload), &rsp));
+	payload[5] ^= 0xff;
+	zassert_ok(cli_set_delta(payload, sizeof(payload), &rsp));
+
+	zassert_equal(sets_sent(), 1);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_DELTA), 1);
+	zassert_equal(srv_state.sets, 2);
+	zassert_equal(srv_state.len, sizeof(payload));
+	zassert_mem_equal(srv_state.data, payload, sizeof(payload));
+}
+
+/* A delta that wouldn't be shorter than the full SET, headers included, is sent as a full SET */
+ZTEST(vnd_models, test_set_delta_max)
+{
+	static uint8_t payload[BT_MESH_VENDOR_MSG_MAXLEN_SET];
+	struct bt_mesh_vendor_status rsp;
+
+	payload_fill(payload, sizeof(payload), 8);
+	zassert_ok(cli_set_delta(payload, sizeof(payload), &rsp));
+
+	/* Ranges of 371 bytes, in a delta of 382 bytes against a SET of 377 */
+	for (int i = 0; i < 365; i++) {
+		payload[i] ^= 0xff;
+	}
+
+	zassert_ok(cli_set_delta(payload, sizeof(payload), &rsp));
+	zassert_equal(sets_sent(), 2);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_DELTA), 0);
+
+	/* A few changed bytes still go as a delta */
+	payload[sizeof(payload) - 1] ^= 0xff;
+	zassert_ok(cli_set_delta(payload, sizeof(payload), &rsp));
+	zassert_equal(sets_sent(), 2);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_DELTA), 1);
+
+	zassert_equal(srv_state.sets, 3);
+	zassert_equal(srv_state.len, sizeof(payload));
+	zassert_mem_equal(srv_state.data, payload, sizeof(payload));
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT) && defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+/* A delta SET sent again after its STATUS was lost applies to the base the first attempt
+ * replaced. The server replays the STATUS instead of rejecting it as stale.
+ */
+ZTEST(vnd_models, test_set_delta_retry)
+{
+	struct bt_mesh_vendor_status rsp;
+	uint8_t payload[48];
+
+	payload_fill(payload, sizeof(payload), 7);
+	zassert_ok(cli_set_delta(payload, sizeof(payload), &rsp));
+
+	payload[5] ^= 0xff;
+	mesh_stub_drop(BT_MESH_VENDOR_OP_STATUS, 1);
+	zassert_ok(cli_set_delta(payload, sizeof(payload), &rsp));
+	zassert_mem_equal(rsp_buf.data, payload, SET_RSP_LEN);
+
+	zassert_equal(sets_sent(), 1);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_SET_DELTA), 2);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_DELTA_STALE), 0);
+	zassert_equal(srv_state.sets, 2);
+	zassert_mem_equal(srv_state.data, payload, sizeof(payload));
+}
+#endif
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_CMD)
+ZTEST(vnd_models, test_cmd)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	struct bt_mesh_vendor_status rsp = { .buf = &rsp_buf };
+	const uint8_t params[] = { 0xde, 0xad, 0xbe, 0xef };
+
+	net_buf_simple_reset(&rsp_buf);
+	zassert_ok(bt_mesh_vendor_cli_cmd(&cli, &ctx, CMD_ECHO, params, sizeof(params), &rsp));
+	zassert_equal(rsp_buf.len, sizeof(params));
+	zassert_mem_equal(rsp_buf.data, params, sizeof(params));
+
+	zassert_equal(bt_mesh_vendor_cli_cmd(&cli, &ctx, CMD_ECHO + 1, NULL, 0, &rsp), -ENOENT);
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT) && defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+/* A command whose response is lost is sent again, and only runs once */
+ZTEST(vnd_models, test_cmd_retry)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	struct bt_mesh_vendor_status rsp = { .buf = &rsp_buf };
+	const uint8_t params[] = { 0xca, 0xfe };
+
+	mesh_stub_drop(BT_MESH_VENDOR_OP_CMD_STATUS, 1);
+
+	net_buf_simple_reset(&rsp_buf);
+	zassert_ok(bt_mesh_vendor_cli_cmd(&cli, &ctx, CMD_ECHO, params, sizeof(params), &rsp));
+	zassert_equal(rsp_buf.len, sizeof(params));
+	zassert_mem_equal(rsp_buf.data, params, sizeof(params));
+
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_CMD), 2);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_CMD_STATUS), 2);
+	zassert_equal(srv_state.cmds, 1);
+}
+#endif
+#endif
+
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+ZTEST(vnd_models, test_kv)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	uint8_t level = 42;
+	uint8_t level_rx = 0;
+	uint32_t serial = 0;
+	struct bt_mesh_vendor_kv_rec set_recs[] = {
+		{ .key = KV_LEVEL, .len = sizeof(level), .value = &level },
+	};
+	struct bt_mesh_vendor_kv_rec get_recs[] = {
+		{ .key = KV_LEVEL, .len = sizeof(level_rx), .value = &level_rx },
+		{ .key = KV_SERIAL, .len = sizeof(serial), .value = &serial },
+	};
+
+	zassert_ok(bt_mesh_vendor_cli_kv_set(&cli, &ctx, set_recs, ARRAY_SIZE(set_recs)));
+	zassert_equal(kv_level, level);
+	zassert_equal(srv_state.kv_changes, 1);
+
+	zassert_ok(bt_mesh_vendor_cli_kv_get(&cli, &ctx, get_recs, ARRAY_SIZE(get_recs)));
+	zassert_equal(get_recs[0].len, sizeof(level_rx));
+	zassert_equal(level_rx, level);
+	zassert_equal(get_recs[1].len, sizeof(serial));
+	zassert_equal(serial, kv_serial);
+
+	/* Read-only keys aren't written */
+	set_recs[0].key = KV_SERIAL;
+	zassert_equal(bt_mesh_vendor_cli_kv_set(&cli, &ctx, set_recs, ARRAY_SIZE(set_recs)),
+		      -EPERM);
+	zassert_equal(srv_state.kv_changes, 1);
+}
+
+#if defined(CONFIG_BT_MESH_VENDOR_CLI_RTT) && defined(CONFIG_BT_MESH_VENDOR_SRV_DUP_CACHE)
+/* A KV SET whose response is lost is sent again, and only reaches the change handler once */
+ZTEST(vnd_models, test_kv_set_retry)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	uint8_t level = 7;
+	struct bt_mesh_vendor_kv_rec rec = {
+		.key = KV_LEVEL,
+		.len = sizeof(level),
+		.value = &level,
+	};
+
+	mesh_stub_drop(BT_MESH_VENDOR_OP_KV_SET_STATUS, 1);
+
+	zassert_ok(bt_mesh_vendor_cli_kv_set(&cli, &ctx, &rec, 1));
+	zassert_equal(kv_level, level);
+
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_KV_SET), 2);
+	zassert_equal(mesh_stub_tx_count(BT_MESH_VENDOR_OP_KV_SET_STATUS), 2);
+	zassert_equal(srv_state.kv_changes, 1);
+}
+#endif
+
+/* Published keys reach the notification handler, replies to requests don't */
+ZTEST(vnd_models, test_kv_publish)
+{
+	struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_APP(0, SRV_ADDR);
+	uint32_t serial = 0;
+	struct bt_mesh_vendor_kv_rec rec = {
+		.key = KV_SERIAL,
+		.len = sizeof(serial),
+		.value = &serial,
+	};
+
+	srv.pub.addr = CLI_ADDR;
+	zassert_ok(bt_mesh_vendor_cli_kv_handler_set(&cli, cli_kv_notify));
+
+	zassert_ok(bt_mesh_vendor_cli_kv_get(&cli, &ctx, &rec, 1));
+	zassert_equal(kv_notified.count, 0);
+
+	kv_level = 7;
+	zassert_ok(bt_mesh_vendor_srv_kv_changed(&srv, KV_LEVEL));
+	k_sleep(K_MSEC(CONFIG_BT_MESH_VENDOR_KV_PUB_DELAY + 10));
+	mesh_stub_flush();
+
+	zassert_equal(kv_notified.count, 1);
+	zassert_equal(kv_notified.key, KV_LEVEL);
+	zassert_equal(kv_notified.len, sizeof(kv_level));
+	zassert_equal(kv_notified.value[0], 7);
+}
+
+static uint8_t kv_empty[1];
+
+static const struct bt_mesh_vendor_kv empty_kvs[] = {
+	BT_MESH_VENDOR_KV(KV_LEVEL, kv_level),
+	{ .value = kv_empty, .key = KV_SERIAL },
+};
+
+static const struct bt_mesh_vendor_kv unsorted_kvs[] = {
+	BT_MESH_VENDOR_KV(KV_SERIAL, kv_serial),
+	BT_MESH_VENDOR_KV(KV_LEVEL, kv_level),
+};
+
+static const struct bt_mesh_vendor_srv_handlers empty_handlers = {
+	.set = srv_set,
+	.get = srv_get,
+	.kvs = empty_kvs,
+	.kv_count = ARRAY_SIZE(empty_kvs),
+};
+
+static const struct bt_mesh_vendor_srv_handlers unsorted_handlers = {
+	.set = srv_set,
+	.get = srv_get,
+	.kvs = unsorted_kvs,
+	.kv_count = ARRAY_SIZE(unsorted_kvs),
+};
+
+static struct bt_mesh_vendor_srv empty_srv = BT_MESH_VENDOR_SRV_INIT(&empty_handlers);
+static struct bt_mesh_vendor_srv unsorted_srv = BT_MESH_VENDOR_SRV_INIT(&unsorted_handlers);
+
+/* Never registered, only initialized */
+static const struct bt_mesh_model invalid_models[] = {
+	BT_MESH_MODEL_VND_SRV(&empty_srv, &empty_handlers),
+	BT_MESH_MODEL_VND_SRV(&unsorted_srv, &unsorted_handlers),
+};
+
+/* Keys must have a value, and be sorted */
+ZTEST(vnd_models, test_kv_table_invalid)
+{
+	for (int i = 0; i < ARRAY_SIZE(invalid_models); i++) {
+		zassert_equal(invalid_models[i].cb->init(&invalid_models[i]), -EINVAL);
+	}
+}
+#endif
+
+static void *vnd_models_setup(void)
+{
+	zassert_ok(mesh_stub_model_add(&cli_models[0], CLI_ADDR));
+	zassert_ok(mesh_stub_model_add(&srv_models[0], SRV_ADDR));
+
+	return NULL;
+}
+
+static void vnd_models_before(void *fixture)
+{
+	mesh_stub_reset();
+
+	srv.pub.addr = BT_MESH_ADDR_UNASSIGNED;
+#if defined(CONFIG_BT_MESH_VENDOR_KV)
+	(void)bt_mesh_vendor_cli_kv_handler_set(&cli, NULL);
+#endif
+	memset(&srv_state, 0, sizeof(srv_state));
+	memset(&kv_notified, 0, sizeof(kv_notified));
+	kv_level = 0;
+}
+
+ZTEST_SUITE(vnd_models, NULL, vnd_models_setup, vnd_models_before, NULL, NULL);
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "vnd_common.h"
+
+#define MIXED_FIELDS(X)    \
+	X(u8, mode)        \
+	X(bits, on, 1)     \
+	X(bits, level, 7)  \
+	X(varint, delay)   \
+	X(bits, a, 3)      \
+	X(bits, b, 12)     \
+	X(le16, id)        \
+	X(bytes, tag, 2)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(mixed_msg, MIXED_FIELDS);
+
+#define VARINT_FIELDS(X) \
+	X(varint, val)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(varint_msg, VARINT_FIELDS);
+
+#define WIDE_FIELDS(X)     \
+	X(bits, flag, 1)   \
+	X(bits, word, 32)
+
+BT_MESH_VENDOR_SCHEMA_DEFINE(wide_msg, WIDE_FIELDS);
+
+static const struct mixed_msg mixed = {
+	.mode = 0xa5,
+	.on = 1,
+	.level = 0x42,
+	.delay = 300,
+	.a = 5,
+	.b = 0xabc,
+	.id = 0x1234,
+	.tag = { 0xde, 0xad },
+};
+
+/* on and level share a byte, and so do a and b, padded after the 15th bit */
+static const uint8_t mixed_encoded[] = {
+	0xa5, 0x85, 0xac, 0x02, 0xe5, 0x55, 0x34, 0x12, 0xde, 0xad,
+};
+
+/* Each bit field is counted on its own, so packing only ever makes messages shorter */
+ZTEST(vnd_schema, test_maxlen)
+{
+	zassert_equal(BT_MESH_VENDOR_SCHEMA_MAXLEN(mixed_msg), 1 + 1 + 1 + 5 + 1 + 2 + 2 + 2);
+	zassert_equal(BT_MESH_VENDOR_SCHEMA_MAXLEN(varint_msg), 5);
+	zassert_equal(BT_MESH_VENDOR_SCHEMA_MAXLEN(wide_msg), 1 + 4);
+}
+
+ZTEST(vnd_schema, test_round_trip)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_VENDOR_SCHEMA_MAXLEN(mixed_msg));
+	struct mixed_msg msg;
+
+	zassert_ok(mixed_msg_encode(&buf, &mixed));
+	zassert_equal(buf.len, sizeof(mixed_encoded));
+	zassert_mem_equal(buf.data, mixed_encoded, sizeof(mixed_encoded));
+
+	memset(&msg, 0, sizeof(msg));
+	zassert_ok(mixed_msg_decode(&buf, &msg));
+	zassert_equal(buf.len, 0);
+	zassert_equal(msg.mode, mixed.mode);
+	zassert_equal(msg.on, mixed.on);
+	zassert_equal(msg.level, mixed.level);
+	zassert_equal(msg.delay, mixed.delay);
+	zassert_equal(msg.a, mixed.a);
+	zassert_equal(msg.b, mixed.b);
+	zassert_equal(msg.id, mixed.id);
+	zassert_mem_equal(msg.tag, mixed.tag, sizeof(msg.tag));
+}
+
+ZTEST(vnd_schema, test_bits_masked)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_VENDOR_SCHEMA_MAXLEN(mixed_msg));
+	struct mixed_msg msg = mixed;
+
+	/* Bits above the width don't spill into the next field */
+	msg.on = 0xfe;
+	msg.a = 0xf8;
+
+	zassert_ok(mixed_msg_encode(&buf, &msg));
+	zassert_equal(buf.data[1], 0x84);
+	zassert_equal(buf.data[4], 0xe0);
+	zassert_equal(buf.data[5], 0x55);
+
+	zassert_ok(mixed_msg_decode(&buf, &msg));
+	zassert_equal(msg.on, 0);
+	zassert_equal(msg.level, mixed.level);
+	zassert_equal(msg.a, 0);
+	zassert_equal(msg.b, mixed.b);
+}
+
+ZTEST(vnd_schema, test_bits_wide)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_VENDOR_SCHEMA_MAXLEN(wide_msg));
+	const uint8_t encoded[] = { 0xff, 0xff, 0xff, 0xff, 0x01 };
+	struct wide_msg msg = { .flag = 1, .word = UINT32_MAX };
+
+	zassert_ok(wide_msg_encode(&buf, &msg));
+	zassert_equal(buf.len, sizeof(encoded));
+	zassert_mem_equal(buf.data, encoded, sizeof(encoded));
+
+	memset(&msg, 0, sizeof(msg));
+	zassert_ok(wide_msg_decode(&buf, &msg));
+	zassert_equal(msg.flag, 1);
+	zassert_equal(msg.word, UINT32_MAX);
+}
+
+ZTEST(vnd_schema, test_varint)
+{
+	static const struct {
+		uint32_t val;
+		uint8_t len;
+		uint8_t encoded[5];
+	} vectors[] = {
+		{ 0, 1, { 0x00 } },
+		{ 0x7f, 1, { 0x7f } },
+		{ 0x80, 2, { 0x80, 0x01 } },
+		{ 0x3fff, 2, { 0xff, 0x7f } },
+		{ 0x4000, 3, { 0x80, 0x80, 0x01 } },
+		{ BIT(28) - 1, 4, { 0xff, 0xff, 0xff, 0x7f } },
+		{ BIT(28), 5, { 0x80, 0x80, 0x80, 0x80, 0x01 } },
+		{ UINT32_MAX, 5, { 0xff, 0xff, 0xff, 0xff, 0x0f } },
+	};
+
+	for (int i = 0; i < ARRAY_SIZE(vectors); i++) {
+		NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_VENDOR_SCHEMA_MAXLEN(varint_msg));
+		struct varint_msg msg = { .val = vectors[i].val };
+
+		zassert_ok(varint_msg_encode(&buf, &msg));
+		zassert_equal(buf.len, vectors[i].len, "0x%08x", vectors[i].val);
+		zassert_mem_equal(buf.data, vectors[i].encoded, vectors[i].len);
+
+		msg.val = 0;
+		zassert_ok(varint_msg_decode(&buf, &msg));
+		zassert_equal(msg.val, vectors[i].val);
+		zassert_equal(buf.len, 0);
+	}
+}
+
+ZTEST(vnd_schema, test_varint_too_long)
+{
+	uint8_t data[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+	struct net_buf_simple buf;
+	struct varint_msg msg;
+
+	net_buf_simple_init_with_data(&buf, data, sizeof(data));
+
+	zassert_equal(varint_msg_decode(&buf, &msg), -EINVAL);
+	zassert_equal(buf.len, sizeof(data));
+}
+
+ZTEST(vnd_schema, test_truncated)
+{
+	uint8_t data[sizeof(mixed_encoded)];
+	struct net_buf_simple buf;
+	struct mixed_msg msg;
+
+	memcpy(data, mixed_encoded, sizeof(data));
+
+	/* Every prefix ends inside a field, and leaves the buffer untouched */
+	for (size_t len = 0; len < sizeof(mixed_encoded); len++) {
+		net_buf_simple_init_with_data(&buf, data, len);
+
+		zassert_equal(mixed_msg_decode(&buf, &msg), -EINVAL, "%zu bytes", len);
+		zassert_equal(buf.len, len);
+		zassert_equal_ptr(buf.data, data);
+	}
+
+	/* A varint with its continuation bit set on the last byte */
+	net_buf_simple_init_with_data(&buf, data, 3);
+	zassert_equal(varint_msg_decode(&buf, &(struct varint_msg){}), -EINVAL);
+}
+
+ZTEST(vnd_schema, test_no_tailroom)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_VENDOR_SCHEMA_MAXLEN(mixed_msg) - 1);
+
+	/* The encoder needs room for the longest encoding, not just this one */
+	zassert_equal(mixed_msg_encode(&buf, &mixed), -ENOBUFS);
+	zassert_equal(buf.len, 0);
+}
+
+ZTEST_SUITE(vnd_schema, NULL, NULL, NULL, NULL, NULL);